@@ -0,0 +1,145 @@
+/**
+ * @file batch_evaluation.cpp
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Реализация пакетного вычисления значений цепных дробей
+ *
+ * Строки коэффициентов заполняются плитками по ROW_TILE строк, чтобы
+ * рабочий буфер помещался в кэш независимо от длины дробей. Внутренний
+ * цикл по BATCH_LANES дорожкам не содержит ветвлений: при наличии AVX
+ * он записан явными интринсиками, иначе компилятор векторизует его сам
+ * (SSE2, AVX-512, NEON - в зависимости от целевой платформы).
+ */
+
+#include "batch_evaluation.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace Math {
+    namespace {
+        constexpr size_t ROW_TILE = 256;   ///< Строк в одной плитке
+        constexpr double PADDING = std::numeric_limits<double>::infinity();
+
+        /**
+         * @brief Применить h = aₖ + 1/h для строк плитки (с последней к первой)
+         * @param rows Строки по BATCH_LANES значений
+         * @param count Количество строк
+         * @param h Текущие значения всех дорожек
+         */
+        void evaluate_rows(const double* rows, size_t count, double* h) {
+            for (size_t r = count; r-- > 0;) {
+                const double* row = rows + r * BATCH_LANES;
+#if defined(__AVX__)
+                const __m256d one = _mm256_set1_pd(1.0);
+                for (size_t j = 0; j < BATCH_LANES; j += 4) {
+                    const __m256d value = _mm256_loadu_pd(h + j);
+                    const __m256d coeff = _mm256_loadu_pd(row + j);
+                    _mm256_storeu_pd(h + j, _mm256_add_pd(coeff, _mm256_div_pd(one, value)));
+                }
+#else
+                for (size_t j = 0; j < BATCH_LANES; ++j) {
+                    h[j] = row[j] + 1.0 / h[j];
+                }
+#endif
+            }
+        }
+
+        /**
+         * @brief Вычислить группу не более чем из BATCH_LANES дробей
+         * @param views Дроби группы
+         * @param count Количество дробей (≤ BATCH_LANES)
+         * @param out Результаты
+         * @param tile Рабочий буфер плитки
+         */
+        void evaluate_group(const ContinuedFractionView* views, size_t count,
+                            double* out, std::vector<double>& tile) {
+            alignas(32) double h[BATCH_LANES];
+            std::fill(std::begin(h), std::end(h), PADDING);
+
+            // Пустое представление - это [0]: одна строка с нулём.
+            // Периодические дроби вычисляются в замкнутом виде отдельно,
+            // их дорожки заполняются только дополнением
+            size_t rows = 1;
+            for (size_t j = 0; j < count; ++j) {
+                if (views[j].is_finite()) {
+                    rows = std::max(rows, views[j].size());
+                }
+            }
+
+            for (size_t end = rows; end > 0;) {
+                const size_t begin = end > ROW_TILE ? end - ROW_TILE : 0;
+
+                // Плитка заполняется по столбцам: коэффициенты читаются подряд
+                for (size_t j = 0; j < BATCH_LANES; ++j) {
+                    const std::span<const long long> coeffs = j < count && views[j].is_finite()
+                        ? views[j].coefficients()
+                        : std::span<const long long>();
+                    const size_t last = std::clamp(coeffs.size(), begin, end);
+                    double* cell = tile.data() + j;
+
+                    size_t k = begin;
+                    for (; k < last; ++k) {
+                        cell[(k - begin) * BATCH_LANES] = static_cast<double>(coeffs[k]);
+                    }
+                    for (; k < end; ++k) {
+                        cell[(k - begin) * BATCH_LANES] = PADDING;
+                    }
+                    if (coeffs.empty() && j < count && begin == 0) {
+                        cell[0] = 0.0;
+                    }
+                }
+
+                evaluate_rows(tile.data(), end - begin, h);
+                end = begin;
+            }
+
+            std::copy(h, h + count, out);
+            for (size_t j = 0; j < count; ++j) {
+                if (views[j].is_periodic()) {
+                    out[j] = views[j].to_double();
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Пакетное вычисление по представлениям
+     */
+    void evaluate_batch(std::span<const ContinuedFractionView> views, std::span<double> out) {
+        if (views.size() != out.size()) {
+            throw std::invalid_argument("Размеры входного и выходного массивов различаются");
+        }
+
+        std::vector<double> tile(ROW_TILE * BATCH_LANES);
+        for (size_t first = 0; first < views.size(); first += BATCH_LANES) {
+            const size_t count = std::min(BATCH_LANES, views.size() - first);
+            evaluate_group(views.data() + first, count, out.data() + first, tile);
+        }
+    }
+
+    /**
+     * @brief Пакетное вычисление по владеющим дробям
+     */
+    void evaluate_batch(std::span<const ContinuedFraction> fractions, std::span<double> out) {
+        if (fractions.size() != out.size()) {
+            throw std::invalid_argument("Размеры входного и выходного массивов различаются");
+        }
+
+        std::vector<double> tile(ROW_TILE * BATCH_LANES);
+        std::array<ContinuedFractionView, BATCH_LANES> views;
+        for (size_t first = 0; first < fractions.size(); first += BATCH_LANES) {
+            const size_t count = std::min(BATCH_LANES, fractions.size() - first);
+            for (size_t j = 0; j < count; ++j) {
+                views[j] = fractions[first + j].view();
+            }
+            evaluate_group(views.data(), count, out.data() + first, tile);
+        }
+    }
+}
@@ -0,0 +1,53 @@
+/**
+ * @file batch_evaluation.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Пакетное вычисление значений многих цепных дробей
+ *
+ * Дроби обрабатываются группами: коэффициенты группы раскладываются
+ * по строкам (structure-of-arrays, одна строка - один индекс
+ * коэффициента для всех дробей группы), и рекуррентная формула
+ * h = aₖ + 1/h выполняется для всей строки сразу векторными
+ * инструкциями. Короткие дроби дополняются значением +∞, которое
+ * не меняет результат: ∞ + 1/∞ = ∞, a + 1/∞ = a.
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef BATCH_EVALUATION_H
+#define BATCH_EVALUATION_H
+
+#include "continued_fraction.h"
+#include <cstddef>
+#include <span>
+
+namespace Math {
+    /**
+     * @brief Количество дробей, вычисляемых одновременно
+     */
+    inline constexpr size_t BATCH_LANES = 32;
+
+    /**
+     * @brief Вычислить значения цепных дробей
+     *
+     * Результат для конечной дроби - значение a₀ + 1/(a₁ + 1/(...)),
+     * вычисленное с конца без ветвлений; пустое представление дает 0.
+     * Периодические дроби вычисляются в замкнутом виде, как
+     * ContinuedFractionView::to_double().
+     *
+     * @param views Дроби
+     * @param out Результаты, out[i] соответствует views[i]
+     * @throw std::invalid_argument Если размеры views и out различаются
+     */
+    void evaluate_batch(std::span<const ContinuedFractionView> views, std::span<double> out);
+
+    /**
+     * @brief Вычислить значения цепных дробей
+     * @param fractions Дроби
+     * @param out Результаты, out[i] соответствует fractions[i]
+     * @throw std::invalid_argument Если размеры fractions и out различаются
+     */
+    void evaluate_batch(std::span<const ContinuedFraction> fractions, std::span<double> out);
+}
+
+#endif // BATCH_EVALUATION_H
@@ -0,0 +1,639 @@
+/**
+ * @file big_integer.cpp
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Реализация целых чисел произвольной точности
+ *
+ * Операции над двумя компактными значениями выполняются в long long
+ * с контролем переполнения; при переполнении или для больших чисел
+ * используются алгоритмы над разрядами: школьное сложение, умножение
+ * школьным алгоритмом или алгоритмом Карацубы, деление по алгоритму D Кнута.
+ */
+
+#include "big_integer.h"
+#include "checked_arithmetic.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace Math {
+    namespace {
+        using Limb = std::uint32_t;
+        using Magnitude = std::vector<Limb>;
+
+        constexpr unsigned LIMB_BITS = 32;
+
+        /**
+         * @brief Модуль long long в виде разрядов
+         */
+        Magnitude magnitude_of(long long value) {
+            unsigned long long mag = value < 0
+                ? 0ULL - static_cast<unsigned long long>(value)
+                : static_cast<unsigned long long>(value);
+            Magnitude result;
+            while (mag != 0) {
+                result.push_back(static_cast<Limb>(mag));
+                mag >>= LIMB_BITS;
+            }
+            return result;
+        }
+
+        /**
+         * @brief Удаление старших нулевых разрядов
+         */
+        void trim(Magnitude& mag) {
+            while (!mag.empty() && mag.back() == 0) {
+                mag.pop_back();
+            }
+        }
+
+        /**
+         * @brief Сравнение модулей
+         */
+        int compare_magnitudes(const Magnitude& a, const Magnitude& b) {
+            if (a.size() != b.size()) {
+                return a.size() < b.size() ? -1 : 1;
+            }
+            for (size_t i = a.size(); i-- > 0; ) {
+                if (a[i] != b[i]) {
+                    return a[i] < b[i] ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+
+        /**
+         * @brief Сумма модулей
+         */
+        Magnitude add_magnitudes(const Magnitude& a, const Magnitude& b) {
+            const Magnitude& longer = a.size() >= b.size() ? a : b;
+            const Magnitude& shorter = a.size() >= b.size() ? b : a;
+
+            Magnitude result(longer.size() + 1);
+            std::uint64_t carry = 0;
+            for (size_t i = 0; i < longer.size(); ++i) {
+                std::uint64_t sum = carry + longer[i] + (i < shorter.size() ? shorter[i] : 0);
+                result[i] = static_cast<Limb>(sum);
+                carry = sum >> LIMB_BITS;
+            }
+            result[longer.size()] = static_cast<Limb>(carry);
+            trim(result);
+            return result;
+        }
+
+        /**
+         * @brief Разность модулей (требуется a ≥ b)
+         */
+        Magnitude subtract_magnitudes(const Magnitude& a, const Magnitude& b) {
+            Magnitude result(a.size());
+            std::int64_t borrow = 0;
+            for (size_t i = 0; i < a.size(); ++i) {
+                std::int64_t diff = static_cast<std::int64_t>(a[i]) - borrow -
+                                    (i < b.size() ? static_cast<std::int64_t>(b[i]) : 0);
+                borrow = diff < 0 ? 1 : 0;
+                result[i] = static_cast<Limb>(diff + (borrow << LIMB_BITS));
+            }
+            trim(result);
+            return result;
+        }
+
+        /**
+         * @brief Длина множителей, начиная с которой применяется алгоритм Карацубы
+         */
+        constexpr size_t KARATSUBA_THRESHOLD = 40;
+
+        /**
+         * @brief Произведение модулей (школьный алгоритм)
+         */
+        Magnitude schoolbook_multiply(const Magnitude& a, const Magnitude& b) {
+            if (a.empty() || b.empty()) {
+                return {};
+            }
+
+            Magnitude result(a.size() + b.size());
+            for (size_t i = 0; i < a.size(); ++i) {
+                std::uint64_t carry = 0;
+                for (size_t j = 0; j < b.size(); ++j) {
+                    std::uint64_t cur = static_cast<std::uint64_t>(a[i]) * b[j] +
+                                        result[i + j] + carry;
+                    result[i + j] = static_cast<Limb>(cur);
+                    carry = cur >> LIMB_BITS;
+                }
+                result[i + b.size()] = static_cast<Limb>(carry);
+            }
+            trim(result);
+            return result;
+        }
+
+        /**
+         * @brief acc += x·2^(32·shift)
+         *
+         * acc должен вмещать сумму: перенос не выходит за его границы.
+         */
+        void add_shifted(Magnitude& acc, const Magnitude& x, size_t shift) {
+            std::uint64_t carry = 0;
+            size_t i = 0;
+            for (; i < x.size(); ++i) {
+                std::uint64_t sum = carry + acc[shift + i] + x[i];
+                acc[shift + i] = static_cast<Limb>(sum);
+                carry = sum >> LIMB_BITS;
+            }
+            for (size_t k = shift + i; carry != 0; ++k) {
+                std::uint64_t sum = carry + acc[k];
+                acc[k] = static_cast<Limb>(sum);
+                carry = sum >> LIMB_BITS;
+            }
+        }
+
+        /**
+         * @brief Разряды модуля с индексами [first, last)
+         */
+        Magnitude slice(const Magnitude& mag, size_t first, size_t last) {
+            first = std::min(first, mag.size());
+            last = std::min(last, mag.size());
+            Magnitude result(mag.begin() + static_cast<std::ptrdiff_t>(first),
+                             mag.begin() + static_cast<std::ptrdiff_t>(last));
+            trim(result);
+            return result;
+        }
+
+        /**
+         * @brief Произведение модулей
+         *
+         * Короткие множители перемножаются школьным алгоритмом, длинные -
+         * алгоритмом Карацубы: a = a₁·Bʰ + a₀, b = b₁·Bʰ + b₀,
+         * a·b = z₂·B²ʰ + z₁·Bʰ + z₀, где z₀ = a₀·b₀, z₂ = a₁·b₁,
+         * z₁ = (a₀ + a₁)(b₀ + b₁) - z₀ - z₂: три умножения половинной длины
+         * вместо четырёх. Если один множитель не длиннее половины другого,
+         * длинный делится пополам, и выполняются два умножения.
+         */
+        Magnitude multiply_magnitudes(const Magnitude& a, const Magnitude& b) {
+            if (std::min(a.size(), b.size()) < KARATSUBA_THRESHOLD) {
+                return schoolbook_multiply(a, b);
+            }
+
+            const Magnitude& longer = a.size() >= b.size() ? a : b;
+            const Magnitude& shorter = a.size() >= b.size() ? b : a;
+            const size_t half = longer.size() / 2;
+
+            Magnitude result(a.size() + b.size());
+            const Magnitude low = slice(longer, 0, half);
+            const Magnitude high = slice(longer, half, longer.size());
+
+            if (shorter.size() <= half) {
+                add_shifted(result, multiply_magnitudes(shorter, low), 0);
+                add_shifted(result, multiply_magnitudes(shorter, high), half);
+            } else {
+                const Magnitude short_low = slice(shorter, 0, half);
+                const Magnitude short_high = slice(shorter, half, shorter.size());
+
+                const Magnitude z0 = multiply_magnitudes(low, short_low);
+                const Magnitude z2 = multiply_magnitudes(high, short_high);
+                Magnitude z1 = multiply_magnitudes(add_magnitudes(low, high),
+                                                   add_magnitudes(short_low, short_high));
+                z1 = subtract_magnitudes(subtract_magnitudes(z1, z0), z2);
+
+                add_shifted(result, z0, 0);
+                add_shifted(result, z1, half);
+                add_shifted(result, z2, 2 * half);
+            }
+            trim(result);
+            return result;
+        }
+
+        /**
+         * @brief Деление модуля на один разряд
+         * @return Остаток
+         */
+        Limb divide_by_limb(const Magnitude& a, Limb divisor, Magnitude& quotient) {
+            quotient.assign(a.size(), 0);
+            std::uint64_t rem = 0;
+            for (size_t i = a.size(); i-- > 0; ) {
+                std::uint64_t cur = (rem << LIMB_BITS) | a[i];
+                quotient[i] = static_cast<Limb>(cur / divisor);
+                rem = cur % divisor;
+            }
+            trim(quotient);
+            return static_cast<Limb>(rem);
+        }
+
+        /**
+         * @brief Деление модулей (алгоритм D Кнута)
+         */
+        void divide_magnitudes(const Magnitude& a, const Magnitude& b,
+                               Magnitude& quotient, Magnitude& remainder) {
+            if (compare_magnitudes(a, b) < 0) {
+                quotient.clear();
+                remainder = a;
+                return;
+            }
+
+            if (b.size() == 1) {
+                Limb rem = divide_by_limb(a, b[0], quotient);
+                remainder.clear();
+                if (rem != 0) {
+                    remainder.push_back(rem);
+                }
+                return;
+            }
+
+            const size_t n = b.size();
+            const size_t m = a.size() - n;
+            const unsigned shift = static_cast<unsigned>(std::countl_zero(b.back()));
+
+            // Нормализация: старший разряд делителя ≥ 2³¹
+            Magnitude vn(n);
+            Magnitude un(a.size() + 1);
+            if (shift == 0) {
+                std::copy(b.begin(), b.end(), vn.begin());
+                std::copy(a.begin(), a.end(), un.begin());
+            } else {
+                for (size_t i = n - 1; i > 0; --i) {
+                    vn[i] = (b[i] << shift) | (b[i - 1] >> (LIMB_BITS - shift));
+                }
+                vn[0] = b[0] << shift;
+                un[a.size()] = a.back() >> (LIMB_BITS - shift);
+                for (size_t i = a.size() - 1; i > 0; --i) {
+                    un[i] = (a[i] << shift) | (a[i - 1] >> (LIMB_BITS - shift));
+                }
+                un[0] = a[0] << shift;
+            }
+
+            constexpr std::uint64_t BASE = 1ULL << LIMB_BITS;
+            quotient.assign(m + 1, 0);
+            for (size_t j = m + 1; j-- > 0; ) {
+                std::uint64_t num = (static_cast<std::uint64_t>(un[j + n]) << LIMB_BITS) | un[j + n - 1];
+                std::uint64_t qhat = num / vn[n - 1];
+                std::uint64_t rhat = num % vn[n - 1];
+
+                while (qhat >= BASE ||
+                       qhat * vn[n - 2] > ((rhat << LIMB_BITS) | un[j + n - 2])) {
+                    --qhat;
+                    rhat += vn[n - 1];
+                    if (rhat >= BASE) {
+                        break;
+                    }
+                }
+
+                // Вычитание qhat·v из текущего окна делимого
+                std::int64_t borrow = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    std::uint64_t p = qhat * vn[i];
+                    std::int64_t t = static_cast<std::int64_t>(un[i + j]) - borrow -
+                                     static_cast<std::int64_t>(p & 0xFFFFFFFFULL);
+                    un[i + j] = static_cast<Limb>(t);
+                    borrow = static_cast<std::int64_t>(p >> LIMB_BITS) - (t >> LIMB_BITS);
+                }
+                std::int64_t t = static_cast<std::int64_t>(un[j + n]) - borrow;
+                un[j + n] = static_cast<Limb>(t);
+
+                quotient[j] = static_cast<Limb>(qhat);
+                if (t < 0) {
+                    // qhat оказался на единицу больше: возвращаем v
+                    --quotient[j];
+                    std::uint64_t carry = 0;
+                    for (size_t i = 0; i < n; ++i) {
+                        std::uint64_t sum = static_cast<std::uint64_t>(un[i + j]) + vn[i] + carry;
+                        un[i + j] = static_cast<Limb>(sum);
+                        carry = sum >> LIMB_BITS;
+                    }
+                    un[j + n] = static_cast<Limb>(un[j + n] + carry);
+                }
+            }
+            trim(quotient);
+
+            // Денормализация остатка
+            remainder.assign(n, 0);
+            if (shift == 0) {
+                std::copy(un.begin(), un.begin() + n, remainder.begin());
+            } else {
+                for (size_t i = 0; i + 1 < n; ++i) {
+                    remainder[i] = (un[i] >> shift) | (un[i + 1] << (LIMB_BITS - shift));
+                }
+                remainder[n - 1] = (un[n - 1] >> shift) | (un[n] << (LIMB_BITS - shift));
+            }
+            trim(remainder);
+        }
+    }
+
+    // ==================== ВНУТРЕННЕЕ ПРЕДСТАВЛЕНИЕ ====================
+
+    /**
+     * @brief Модуль числа в виде разрядов
+     */
+    BigInt::Magnitude BigInt::magnitude() const {
+        return is_small() ? magnitude_of(small_) : limbs_;
+    }
+
+    /**
+     * @brief Сборка числа из модуля и знака
+     */
+    BigInt BigInt::from_magnitude(Magnitude mag, bool negative) {
+        trim(mag);
+
+        if (mag.size() <= 2) {
+            std::uint64_t value = 0;
+            for (size_t i = mag.size(); i-- > 0; ) {
+                value = (value << LIMB_BITS) | mag[i];
+            }
+
+            constexpr std::uint64_t max_positive =
+                static_cast<std::uint64_t>(std::numeric_limits<long long>::max());
+            if (value <= max_positive) {
+                long long v = static_cast<long long>(value);
+                return BigInt(negative ? -v : v);
+            }
+            if (negative && value == max_positive + 1) {
+                return BigInt(std::numeric_limits<long long>::min());
+            }
+        }
+
+        BigInt result;
+        result.limbs_ = std::move(mag);
+        result.negative_ = negative;
+        return result;
+    }
+
+    /**
+     * @brief Разбор десятичной записи
+     */
+    BigInt BigInt::from_string(std::string_view str) {
+        bool negative = false;
+        if (!str.empty() && (str.front() == '-' || str.front() == '+')) {
+            negative = str.front() == '-';
+            str.remove_prefix(1);
+        }
+        if (str.empty()) {
+            throw std::invalid_argument("Пустая запись целого числа");
+        }
+
+        Magnitude mag;
+        for (char ch : str) {
+            if (ch < '0' || ch > '9') {
+                throw std::invalid_argument("Неверный символ в записи целого числа");
+            }
+            // mag = mag·10 + digit
+            std::uint64_t carry = static_cast<std::uint64_t>(ch - '0');
+            for (Limb& limb : mag) {
+                std::uint64_t cur = static_cast<std::uint64_t>(limb) * 10 + carry;
+                limb = static_cast<Limb>(cur);
+                carry = cur >> LIMB_BITS;
+            }
+            if (carry != 0) {
+                mag.push_back(static_cast<Limb>(carry));
+            }
+        }
+        return from_magnitude(std::move(mag), negative);
+    }
+
+    /**
+     * @brief Степень двойки: один ненулевой разряд
+     */
+    BigInt BigInt::power_of_two(size_t exponent) {
+        if (exponent < 63) {
+            return BigInt(1LL << exponent);
+        }
+        Magnitude mag(exponent / LIMB_BITS + 1, 0);
+        mag.back() = Limb{1} << (exponent % LIMB_BITS);
+        return from_magnitude(std::move(mag), false);
+    }
+
+    // ==================== СВОЙСТВА ====================
+
+    /**
+     * @brief Знак числа
+     */
+    int BigInt::sign() const {
+        if (is_small()) {
+            return (small_ > 0) - (small_ < 0);
+        }
+        return negative_ ? -1 : 1;
+    }
+
+    /**
+     * @brief Количество значащих бит модуля
+     */
+    size_t BigInt::bit_length() const {
+        if (is_small()) {
+            unsigned long long mag = small_ < 0
+                ? 0ULL - static_cast<unsigned long long>(small_)
+                : static_cast<unsigned long long>(small_);
+            return static_cast<size_t>(std::bit_width(mag));
+        }
+        return (limbs_.size() - 1) * LIMB_BITS + static_cast<size_t>(std::bit_width(limbs_.back()));
+    }
+
+    // ==================== ПРЕОБРАЗОВАНИЯ ====================
+
+    /**
+     * @brief Значение как long long
+     *
+     * Большое представление используется только для значений,
+     * не помещающихся в long long.
+     */
+    std::optional<long long> BigInt::to_int64() const {
+        if (is_small()) {
+            return small_;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Приближенное значение double по трём старшим разрядам
+     */
+    double BigInt::to_double() const {
+        if (is_small()) {
+            return static_cast<double>(small_);
+        }
+
+        double value = 0.0;
+        const size_t top = limbs_.size();
+        const size_t used = std::min<size_t>(top, 3);
+        for (size_t i = 0; i < used; ++i) {
+            value = value * 4294967296.0 + limbs_[top - 1 - i];
+        }
+        value = std::ldexp(value, static_cast<int>((top - used) * LIMB_BITS));
+        return negative_ ? -value : value;
+    }
+
+    /**
+     * @brief Десятичная запись
+     */
+    std::string BigInt::to_string() const {
+        if (is_small()) {
+            return std::to_string(small_);
+        }
+
+        // Выделение блоков по 9 десятичных цифр
+        std::vector<Limb> chunks;
+        Magnitude current = limbs_;
+        Magnitude next;
+        while (!current.empty()) {
+            chunks.push_back(divide_by_limb(current, 1000000000U, next));
+            current.swap(next);
+        }
+
+        std::string result = negative_ ? "-" : "";
+        result += std::to_string(chunks.back());
+        for (size_t i = chunks.size() - 1; i-- > 0; ) {
+            std::string part = std::to_string(chunks[i]);
+            result.append(9 - part.size(), '0');
+            result += part;
+        }
+        return result;
+    }
+
+    // ==================== АРИФМЕТИКА ====================
+
+    BigInt BigInt::operator-() const {
+        if (is_small() && small_ != std::numeric_limits<long long>::min()) {
+            return BigInt(-small_);
+        }
+        return from_magnitude(magnitude(), !is_negative());
+    }
+
+    BigInt BigInt::abs() const {
+        return is_negative() ? -*this : *this;
+    }
+
+    /**
+     * @brief Сложение
+     */
+    BigInt& BigInt::operator+=(const BigInt& other) {
+        if (is_small() && other.is_small()) {
+            long long sum;
+            if (detail::checked_add(small_, other.small_, sum)) {
+                small_ = sum;
+                return *this;
+            }
+        }
+
+        const bool neg_a = is_negative();
+        const bool neg_b = other.is_negative();
+        Magnitude a = magnitude();
+        Magnitude b = other.magnitude();
+
+        if (neg_a == neg_b) {
+            *this = from_magnitude(add_magnitudes(a, b), neg_a);
+        } else if (compare_magnitudes(a, b) >= 0) {
+            *this = from_magnitude(subtract_magnitudes(a, b), neg_a);
+        } else {
+            *this = from_magnitude(subtract_magnitudes(b, a), neg_b);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Вычитание
+     */
+    BigInt& BigInt::operator-=(const BigInt& other) {
+        if (is_small() && other.is_small()) {
+            long long diff;
+            if (detail::checked_sub(small_, other.small_, diff)) {
+                small_ = diff;
+                return *this;
+            }
+        }
+        return *this += -other;
+    }
+
+    /**
+     * @brief Умножение
+     */
+    BigInt operator*(const BigInt& a, const BigInt& b) {
+        if (a.is_small() && b.is_small()) {
+            long long product;
+            if (detail::checked_mul(a.small_, b.small_, product)) {
+                return BigInt(product);
+            }
+        }
+        return BigInt::from_magnitude(multiply_magnitudes(a.magnitude(), b.magnitude()),
+                                      a.is_negative() != b.is_negative());
+    }
+
+    BigInt& BigInt::operator*=(const BigInt& other) {
+        return *this = *this * other;
+    }
+
+    /**
+     * @brief Деление с усечением к нулю
+     */
+    void BigInt::divmod(const BigInt& a, const BigInt& b,
+                        BigInt& quotient, BigInt& remainder) {
+        if (b.is_zero()) {
+            throw std::domain_error("Деление BigInt на ноль");
+        }
+
+        if (a.is_small() && b.is_small() &&
+            !(a.small_ == std::numeric_limits<long long>::min() && b.small_ == -1)) {
+            const long long q = a.small_ / b.small_;
+            const long long r = a.small_ % b.small_;
+            quotient = BigInt(q);
+            remainder = BigInt(r);
+            return;
+        }
+
+        Magnitude q;
+        Magnitude r;
+        divide_magnitudes(a.magnitude(), b.magnitude(), q, r);
+        const bool neg_a = a.is_negative();
+        quotient = from_magnitude(std::move(q), neg_a != b.is_negative());
+        remainder = from_magnitude(std::move(r), neg_a);
+    }
+
+    /**
+     * @brief Деление с округлением частного вниз
+     */
+    void BigInt::floor_divmod(const BigInt& a, const BigInt& b,
+                              BigInt& quotient, BigInt& remainder) {
+        divmod(a, b, quotient, remainder);
+        if (!remainder.is_zero() && remainder.is_negative() != b.is_negative()) {
+            quotient -= 1;
+            remainder += b;
+        }
+    }
+
+    BigInt& BigInt::operator/=(const BigInt& other) {
+        BigInt remainder;
+        divmod(*this, other, *this, remainder);
+        return *this;
+    }
+
+    BigInt& BigInt::operator%=(const BigInt& other) {
+        BigInt quotient;
+        divmod(*this, other, quotient, *this);
+        return *this;
+    }
+
+    // ==================== СРАВНЕНИЕ ====================
+
+    bool operator==(const BigInt& a, const BigInt& b) {
+        if (a.is_small() != b.is_small()) {
+            return false;
+        }
+        if (a.is_small()) {
+            return a.small_ == b.small_;
+        }
+        return a.negative_ == b.negative_ && a.limbs_ == b.limbs_;
+    }
+
+    std::strong_ordering operator<=>(const BigInt& a, const BigInt& b) {
+        if (a.is_small() && b.is_small()) {
+            return a.small_ <=> b.small_;
+        }
+
+        const bool neg_a = a.is_negative();
+        const bool neg_b = b.is_negative();
+        if (neg_a != neg_b) {
+            return neg_a ? std::strong_ordering::less : std::strong_ordering::greater;
+        }
+
+        int cmp = compare_magnitudes(a.magnitude(), b.magnitude());
+        if (neg_a) {
+            cmp = -cmp;
+        }
+        return cmp <=> 0;
+    }
+}
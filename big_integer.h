@@ -0,0 +1,171 @@
+/**
+ * @file big_integer.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Целые числа произвольной точности
+ *
+ * BigInt хранит значения, помещающиеся в long long, непосредственно
+ * в объекте (без выделения памяти), и переходит к представлению
+ * массивом 32-битных разрядов только при переполнении. Поэтому
+ * вычисления с небольшими числами выполняются почти так же быстро,
+ * как с long long, а большие числа обрабатываются точно.
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef BIG_INTEGER_H
+#define BIG_INTEGER_H
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Math {
+    /**
+     * @class BigInt
+     * @brief Знаковое целое число произвольной точности
+     *
+     * Деление (/ и %) выполняется с усечением к нулю, как у встроенных
+     * целых типов; floor_divmod() округляет частное вниз.
+     */
+    class BigInt {
+    public:
+        // ==================== КОНСТРУКТОРЫ ====================
+
+        /**
+         * @brief Конструктор по умолчанию (значение 0)
+         */
+        BigInt() : small_(0), negative_(false) {}
+
+        /**
+         * @brief Конструктор из long long
+         * @param value Значение
+         */
+        BigInt(long long value) : small_(value), negative_(false) {}
+
+        /**
+         * @brief Разбор десятичной записи
+         * @param str Строка вида "-123456789..."
+         * @return Число
+         * @throw std::invalid_argument При неверном формате
+         */
+        static BigInt from_string(std::string_view str);
+
+        /**
+         * @brief Степень двойки 2^exponent
+         * @param exponent Показатель
+         * @return Число
+         */
+        static BigInt power_of_two(size_t exponent);
+
+        // ==================== СВОЙСТВА ====================
+
+        /**
+         * @brief Хранится ли значение без выделения памяти
+         */
+        bool is_small() const { return limbs_.empty(); }
+
+        /**
+         * @brief Проверка на ноль
+         */
+        bool is_zero() const { return is_small() && small_ == 0; }
+
+        /**
+         * @brief Проверка на отрицательность
+         */
+        bool is_negative() const { return is_small() ? small_ < 0 : negative_; }
+
+        /**
+         * @brief Знак числа
+         * @return -1, 0 или 1
+         */
+        int sign() const;
+
+        /**
+         * @brief Количество значащих бит модуля
+         */
+        size_t bit_length() const;
+
+        // ==================== ПРЕОБРАЗОВАНИЯ ====================
+
+        /**
+         * @brief Значение как long long, если оно помещается
+         */
+        std::optional<long long> to_int64() const;
+
+        /**
+         * @brief Приближенное значение типа double
+         */
+        double to_double() const;
+
+        /**
+         * @brief Десятичная запись
+         */
+        std::string to_string() const;
+
+        // ==================== АРИФМЕТИКА ====================
+
+        BigInt operator-() const;
+        BigInt abs() const;
+
+        BigInt& operator+=(const BigInt& other);
+        BigInt& operator-=(const BigInt& other);
+        BigInt& operator*=(const BigInt& other);
+        BigInt& operator/=(const BigInt& other);
+        BigInt& operator%=(const BigInt& other);
+
+        friend BigInt operator+(BigInt a, const BigInt& b) { return a += b; }
+        friend BigInt operator-(BigInt a, const BigInt& b) { return a -= b; }
+        friend BigInt operator*(const BigInt& a, const BigInt& b);
+        friend BigInt operator/(BigInt a, const BigInt& b) { return a /= b; }
+        friend BigInt operator%(BigInt a, const BigInt& b) { return a %= b; }
+
+        /**
+         * @brief Деление с остатком (частное усекается к нулю)
+         * @throw std::domain_error При делении на ноль
+         */
+        static void divmod(const BigInt& a, const BigInt& b,
+                           BigInt& quotient, BigInt& remainder);
+
+        /**
+         * @brief Деление с остатком (частное округляется вниз)
+         *
+         * Остаток имеет знак делителя: a = q·b + r, 0 ≤ |r| < |b|.
+         * @throw std::domain_error При делении на ноль
+         */
+        static void floor_divmod(const BigInt& a, const BigInt& b,
+                                 BigInt& quotient, BigInt& remainder);
+
+        // ==================== СРАВНЕНИЕ ====================
+
+        friend bool operator==(const BigInt& a, const BigInt& b);
+        friend std::strong_ordering operator<=>(const BigInt& a, const BigInt& b);
+
+    private:
+        using Limb = std::uint32_t;           ///< Разряд по основанию 2³²
+        using Magnitude = std::vector<Limb>;  ///< Модуль, младшие разряды первыми
+
+        long long small_;     ///< Значение, если limbs_ пуст
+        Magnitude limbs_;     ///< Модуль большого числа
+        bool negative_;       ///< Знак большого числа
+
+        /**
+         * @brief Модуль числа в виде разрядов
+         */
+        Magnitude magnitude() const;
+
+        /**
+         * @brief Собрать число из модуля и знака
+         *
+         * Отбрасывает старшие нулевые разряды и переходит к компактному
+         * представлению, если значение помещается в long long.
+         */
+        static BigInt from_magnitude(Magnitude mag, bool negative);
+    };
+}
+
+#endif // BIG_INTEGER_H
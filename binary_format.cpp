@@ -0,0 +1,439 @@
+/**
+ * @file binary_format.cpp
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Реализация двоичного формата и архива с отображением в память
+ *
+ * Коэффициенты кодируются варинтами (по 7 бит на байт, старший бит -
+ * признак продолжения) после зигзаг-преобразования, поэтому небольшие
+ * по модулю коэффициенты любого знака занимают один байт.
+ */
+
+#include "binary_format.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Math {
+    namespace {
+        constexpr std::uint8_t ARCHIVE_MAGIC[4] = {'C', 'F', 'A', 'R'};
+        constexpr size_t ARCHIVE_HEADER_SIZE = 16;   // сигнатура, версия, количество
+        constexpr size_t MAX_VARINT_BYTES = 10;      // ⌈64 / 7⌉
+
+        /**
+         * @brief Зигзаг-преобразование: 0, -1, 1, -2, ... → 0, 1, 2, 3, ...
+         */
+        std::uint64_t zigzag_encode(long long value) {
+            return (static_cast<std::uint64_t>(value) << 1) ^
+                   static_cast<std::uint64_t>(value >> 63);
+        }
+
+        /**
+         * @brief Обратное зигзаг-преобразование
+         */
+        long long zigzag_decode(std::uint64_t value) {
+            return static_cast<long long>((value >> 1) ^ (0 - (value & 1)));
+        }
+
+        void put_varint(std::uint64_t value, std::vector<std::uint8_t>& out) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<std::uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        /**
+         * @brief Прочитать варинт из [data, end)
+         * @param base Начало записи (для позиции ошибки)
+         * @throw ParseError Если варинт обрывается или не помещается в 64 бита
+         */
+        std::uint64_t get_varint(const std::uint8_t*& data, const std::uint8_t* end,
+                                 const std::uint8_t* base) {
+            std::uint64_t value = 0;
+            for (size_t i = 0; i < MAX_VARINT_BYTES; ++i) {
+                if (data == end) {
+                    throw ParseError("Двоичная запись обрывается посреди числа",
+                                     static_cast<size_t>(data - base));
+                }
+                const std::uint8_t byte = *data++;
+                if (i == MAX_VARINT_BYTES - 1 && byte > 1) {
+                    break;
+                }
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << (7 * i);
+                if ((byte & 0x80) == 0) {
+                    return value;
+                }
+            }
+            throw ParseError("Число в двоичной записи превышает 64 бита",
+                             static_cast<size_t>(data - base));
+        }
+
+        void put_u32(std::uint32_t value, std::vector<std::uint8_t>& out) {
+            for (int i = 0; i < 4; ++i) {
+                out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        void put_u64(std::uint64_t value, std::vector<std::uint8_t>& out) {
+            for (int i = 0; i < 8; ++i) {
+                out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        std::uint32_t get_u32(const std::uint8_t* data) {
+            std::uint32_t value = 0;
+            for (int i = 0; i < 4; ++i) {
+                value |= static_cast<std::uint32_t>(data[i]) << (8 * i);
+            }
+            return value;
+        }
+
+        std::uint64_t get_u64(const std::uint8_t* data) {
+            std::uint64_t value = 0;
+            for (int i = 0; i < 8; ++i) {
+                value |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+            }
+            return value;
+        }
+    }
+
+    // ==================== ОДИНОЧНЫЕ ЗАПИСИ ====================
+
+    /**
+     * @brief Кодирование цепной дроби
+     */
+    void append_binary(const ContinuedFraction& cf, std::vector<std::uint8_t>& out) {
+        const std::span<const long long> coeffs = cf.coefficients();
+        const bool periodic = cf.is_periodic();
+
+        put_varint((static_cast<std::uint64_t>(coeffs.size()) << 2) |
+                   (periodic ? BinaryRecordView::FLAG_PERIODIC : 0), out);
+        if (periodic) {
+            put_varint(cf.period_start(), out);
+        }
+        for (long long coeff : coeffs) {
+            put_varint(zigzag_encode(coeff), out);
+        }
+    }
+
+    std::vector<std::uint8_t> to_binary(const ContinuedFraction& cf) {
+        std::vector<std::uint8_t> out;
+        append_binary(cf, out);
+        return out;
+    }
+
+    ContinuedFraction from_binary(std::span<const std::uint8_t> bytes) {
+        return BinaryRecordView(bytes).decode();
+    }
+
+    // ==================== ПРЕДСТАВЛЕНИЕ ЗАПИСИ ====================
+
+    /**
+     * @brief Разбор заголовка записи
+     */
+    BinaryRecordView::BinaryRecordView(std::span<const std::uint8_t> bytes)
+        : bytes_(bytes), size_(0), period_start_(ContinuedFraction::npos) {
+        const std::uint8_t* base = bytes.data();
+        const std::uint8_t* data = base;
+        const std::uint8_t* end = base + bytes.size();
+
+        const std::uint64_t header = get_varint(data, end, base);
+        if ((header & FLAG_BIGNUM) != 0) {
+            throw ParseError("Коэффициенты произвольной точности не поддерживаются в версии 1", 0);
+        }
+
+        const std::uint64_t count = header >> 2;
+        // Каждый коэффициент занимает хотя бы один байт
+        if (count == 0 || count > static_cast<std::uint64_t>(end - data)) {
+            throw ParseError("Неверное количество коэффициентов в двоичной записи", 0);
+        }
+        size_ = static_cast<size_t>(count);
+
+        if ((header & FLAG_PERIODIC) != 0) {
+            const size_t position = static_cast<size_t>(data - base);
+            const std::uint64_t start = get_varint(data, end, base);
+            if (start >= count) {
+                throw ParseError("Начало периода за пределами двоичной записи", position);
+            }
+            period_start_ = static_cast<size_t>(start);
+        }
+
+        payload_ = bytes.subspan(static_cast<size_t>(data - base));
+    }
+
+    /**
+     * @brief Декодирование очередного коэффициента итератором
+     *
+     * После последнего коэффициента запись должна закончиться.
+     */
+    void BinaryRecordView::const_iterator::load() {
+        if (remaining_ != 0) {
+            value_ = zigzag_decode(get_varint(data_, end_, base_));
+        } else if (data_ != end_) {
+            throw ParseError("Лишние байты после коэффициентов двоичной записи",
+                             static_cast<size_t>(data_ - base_));
+        }
+    }
+
+    ContinuedFractionView BinaryRecordView::decode_into(std::vector<long long>& out) const {
+        out.clear();
+        out.reserve(size_);
+        for (long long coeff : *this) {
+            out.push_back(coeff);
+        }
+        return ContinuedFractionView(out, period_start_);
+    }
+
+    ContinuedFraction BinaryRecordView::decode() const {
+        if (size_ == 0) {
+            return ContinuedFraction();
+        }
+
+        ContinuedFraction::Builder builder(size_);
+        size_t index = 0;
+        for (long long coeff : *this) {
+            if (index++ == period_start_) {
+                builder.begin_period();
+            }
+            builder.push_back(coeff);
+        }
+        return builder.finish();
+    }
+
+    // ==================== ЗАПИСЬ АРХИВА ====================
+
+    void ArchiveWriter::add(const ContinuedFraction& cf) {
+        append_binary(cf, data_);
+        offsets_.push_back(data_.size());
+    }
+
+    /**
+     * @brief Сборка архива: заголовок, таблица смещений, данные
+     */
+    std::vector<std::uint8_t> ArchiveWriter::finish() const {
+        std::vector<std::uint8_t> out;
+        out.reserve(ARCHIVE_HEADER_SIZE + 8 * offsets_.size() + data_.size());
+
+        for (std::uint8_t byte : ARCHIVE_MAGIC) {
+            out.push_back(byte);
+        }
+        put_u32(BINARY_FORMAT_VERSION, out);
+        put_u64(size(), out);
+        for (std::uint64_t offset : offsets_) {
+            put_u64(offset, out);
+        }
+        out.insert(out.end(), data_.begin(), data_.end());
+        return out;
+    }
+
+    void ArchiveWriter::write_file(const std::string& path) const {
+        const std::vector<std::uint8_t> bytes = finish();
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Не удалось открыть файл для записи: " + path);
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()),
+                   static_cast<std::streamsize>(bytes.size()));
+        if (!file) {
+            throw std::runtime_error("Ошибка записи файла: " + path);
+        }
+    }
+
+    // ==================== ПРЕДСТАВЛЕНИЕ АРХИВА ====================
+
+    /**
+     * @brief Проверка заголовка и таблицы смещений
+     *
+     * Смещения должны не убывать и не выходить за пределы данных,
+     * тогда любая запись - корректный поддиапазон байтов.
+     */
+    ArchiveView::ArchiveView(std::span<const std::uint8_t> bytes) : count_(0) {
+        if (bytes.size() < ARCHIVE_HEADER_SIZE ||
+            std::memcmp(bytes.data(), ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC)) != 0) {
+            throw ParseError("Неверная сигнатура архива цепных дробей", 0);
+        }
+
+        const std::uint32_t version = get_u32(bytes.data() + 4);
+        if (version != BINARY_FORMAT_VERSION) {
+            throw ParseError("Неподдерживаемая версия архива: " + std::to_string(version), 4);
+        }
+
+        const std::uint64_t count = get_u64(bytes.data() + 8);
+        const size_t available = bytes.size() - ARCHIVE_HEADER_SIZE;
+        if (count >= available / 8) {
+            throw ParseError("Таблица смещений выходит за пределы архива", 8);
+        }
+
+        count_ = static_cast<size_t>(count);
+        const size_t table_size = 8 * (count_ + 1);
+        offsets_ = bytes.subspan(ARCHIVE_HEADER_SIZE, table_size);
+        data_ = bytes.subspan(ARCHIVE_HEADER_SIZE + table_size);
+
+        std::uint64_t previous = 0;
+        for (size_t i = 0; i <= count_; ++i) {
+            const std::uint64_t current = offset(i);
+            if (current < previous || current > data_.size() || (i == 0 && current != 0)) {
+                throw ParseError("Повреждена таблица смещений архива",
+                                 ARCHIVE_HEADER_SIZE + 8 * i);
+            }
+            previous = current;
+        }
+    }
+
+    std::uint64_t ArchiveView::offset(size_t i) const {
+        return get_u64(offsets_.data() + 8 * i);
+    }
+
+    BinaryRecordView ArchiveView::operator[](size_t index) const {
+        const size_t first = static_cast<size_t>(offset(index));
+        const size_t last = static_cast<size_t>(offset(index + 1));
+        return BinaryRecordView(data_.subspan(first, last - first));
+    }
+
+    BinaryRecordView ArchiveView::at(size_t index) const {
+        if (index >= count_) {
+            throw std::out_of_range("Индекс записи вне диапазона архива");
+        }
+        return (*this)[index];
+    }
+
+    // ==================== ОТОБРАЖЕНИЕ ФАЙЛА ====================
+
+    /**
+     * @brief Открытие и отображение файла
+     */
+    MappedArchive::MappedArchive(const std::string& path)
+        : data_(nullptr)
+        , length_(0)
+#ifdef _WIN32
+        , file_(nullptr)
+        , mapping_(nullptr)
+#endif
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error("Не удалось открыть архив: " + path);
+        }
+        file_ = file;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            release();
+            throw std::runtime_error("Не удалось определить размер архива: " + path);
+        }
+        length_ = static_cast<size_t>(size.QuadPart);
+
+        if (length_ != 0) {
+            HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping == nullptr) {
+                release();
+                throw std::runtime_error("Не удалось отобразить архив в память: " + path);
+            }
+            mapping_ = mapping;
+
+            data_ = static_cast<const std::uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            if (data_ == nullptr) {
+                release();
+                throw std::runtime_error("Не удалось отобразить архив в память: " + path);
+            }
+        }
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Не удалось открыть архив: " + path);
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::runtime_error("Не удалось определить размер архива: " + path);
+        }
+        length_ = static_cast<size_t>(info.st_size);
+
+        if (length_ != 0) {
+            void* mapped = ::mmap(nullptr, length_, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("Не удалось отобразить архив в память: " + path);
+            }
+            data_ = static_cast<const std::uint8_t*>(mapped);
+        }
+        // Отображение остаётся действительным после закрытия дескриптора
+        ::close(fd);
+#endif
+
+        try {
+            view_ = ArchiveView(std::span<const std::uint8_t>(data_, length_));
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+
+    MappedArchive::~MappedArchive() {
+        release();
+    }
+
+    MappedArchive::MappedArchive(MappedArchive&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr))
+        , length_(std::exchange(other.length_, 0))
+#ifdef _WIN32
+        , file_(std::exchange(other.file_, nullptr))
+        , mapping_(std::exchange(other.mapping_, nullptr))
+#endif
+        , view_(std::exchange(other.view_, ArchiveView())) {}
+
+    MappedArchive& MappedArchive::operator=(MappedArchive&& other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = std::exchange(other.data_, nullptr);
+            length_ = std::exchange(other.length_, 0);
+#ifdef _WIN32
+            file_ = std::exchange(other.file_, nullptr);
+            mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+            view_ = std::exchange(other.view_, ArchiveView());
+        }
+        return *this;
+    }
+
+    void MappedArchive::release() noexcept {
+#ifdef _WIN32
+        if (data_ != nullptr) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_ != nullptr) {
+            CloseHandle(static_cast<HANDLE>(mapping_));
+        }
+        if (file_ != nullptr) {
+            CloseHandle(static_cast<HANDLE>(file_));
+        }
+        file_ = nullptr;
+        mapping_ = nullptr;
+#else
+        if (data_ != nullptr) {
+            ::munmap(const_cast<std::uint8_t*>(data_), length_);
+        }
+#endif
+        data_ = nullptr;
+        length_ = 0;
+        view_ = ArchiveView();
+    }
+}
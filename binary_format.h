@@ -0,0 +1,327 @@
+/**
+ * @file binary_format.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Компактный двоичный формат цепных дробей и архив с отображением в память
+ *
+ * Запись (версия 1):
+ *   varint  заголовок = (количество коэффициентов << 2) | флаги
+ *   varint  начало периода (только при флаге FLAG_PERIODIC)
+ *   varint  коэффициенты в зигзаг-кодировке
+ *
+ * Флаг FLAG_BIGNUM зарезервирован под коэффициенты произвольной точности
+ * и в версии 1 не используется; читатель отвергает такие записи.
+ *
+ * Архив:
+ *   4 байта  сигнатура "CFAR"
+ *   uint32   версия формата
+ *   uint64   количество записей N
+ *   uint64   N + 1 смещений записей относительно начала данных
+ *   ...      данные записей
+ *
+ * Все многобайтовые поля хранятся в порядке little-endian.
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef BINARY_FORMAT_H
+#define BINARY_FORMAT_H
+
+#include "continued_fraction.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Math {
+    /**
+     * @brief Версия двоичного формата
+     */
+    inline constexpr std::uint32_t BINARY_FORMAT_VERSION = 1;
+
+    // ==================== ОДИНОЧНЫЕ ЗАПИСИ ====================
+
+    /**
+     * @brief Дописать двоичную запись цепной дроби в буфер
+     * @param cf Цепная дробь
+     * @param out Буфер, в конец которого добавляется запись
+     */
+    void append_binary(const ContinuedFraction& cf, std::vector<std::uint8_t>& out);
+
+    /**
+     * @brief Двоичная запись цепной дроби
+     * @param cf Цепная дробь
+     * @return Байты записи
+     */
+    std::vector<std::uint8_t> to_binary(const ContinuedFraction& cf);
+
+    /**
+     * @brief Восстановить цепную дробь из двоичной записи
+     * @param bytes Байты ровно одной записи
+     * @return Цепная дробь
+     * @throw ParseError При повреждённой записи (позиция - смещение в байтах)
+     */
+    ContinuedFraction from_binary(std::span<const std::uint8_t> bytes);
+
+    /**
+     * @class BinaryRecordView
+     * @brief Невладеющее представление одной двоичной записи
+     *
+     * Разбирает только заголовок; коэффициенты декодируются
+     * по мере обхода итератором. Байты должны жить дольше представления.
+     */
+    class BinaryRecordView {
+    public:
+        static constexpr std::uint64_t FLAG_PERIODIC = 1;  ///< Есть начало периода
+        static constexpr std::uint64_t FLAG_BIGNUM = 2;    ///< Зарезервировано
+
+        /**
+         * @class const_iterator
+         * @brief Однопроходный итератор по коэффициентам записи
+         */
+        class const_iterator {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = long long;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const long long*;
+            using reference = const long long&;
+
+            const_iterator() : base_(nullptr), data_(nullptr), end_(nullptr), remaining_(0), value_(0) {}
+
+            reference operator*() const { return value_; }
+            pointer operator->() const { return &value_; }
+
+            const_iterator& operator++() {
+                --remaining_;
+                load();
+                return *this;
+            }
+
+            const_iterator operator++(int) {
+                const_iterator copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            friend bool operator==(const const_iterator& a, const const_iterator& b) {
+                return a.remaining_ == b.remaining_;
+            }
+
+        private:
+            friend class BinaryRecordView;
+
+            const_iterator(const std::uint8_t* base, const std::uint8_t* data,
+                           const std::uint8_t* end, size_t remaining)
+                : base_(base), data_(data), end_(end), remaining_(remaining), value_(0) {
+                load();
+            }
+
+            /**
+             * @brief Декодировать текущий коэффициент
+             * @throw ParseError Если запись обрывается посреди коэффициента
+             *        или после последнего коэффициента остаются байты
+             */
+            void load();
+
+            const std::uint8_t* base_;   ///< Начало записи (для позиции ошибки)
+            const std::uint8_t* data_;   ///< Следующий непрочитанный байт
+            const std::uint8_t* end_;    ///< Конец записи
+            size_t remaining_;           ///< Коэффициентов до конца (включая текущий)
+            long long value_;            ///< Текущий коэффициент
+        };
+
+        /**
+         * @brief Пустое представление (дробь [0] без байтов)
+         */
+        BinaryRecordView() : size_(0), period_start_(ContinuedFraction::npos) {}
+
+        /**
+         * @brief Представление над байтами записи
+         * @param bytes Байты ровно одной записи
+         * @throw ParseError При повреждённом заголовке
+         */
+        explicit BinaryRecordView(std::span<const std::uint8_t> bytes);
+
+        /**
+         * @brief Количество коэффициентов
+         */
+        size_t size() const { return size_; }
+
+        /**
+         * @brief Индекс начала периода или ContinuedFraction::npos
+         */
+        size_t period_start() const { return period_start_; }
+
+        /**
+         * @brief Является ли запись периодической дробью
+         */
+        bool is_periodic() const { return period_start_ != ContinuedFraction::npos; }
+
+        /**
+         * @brief Байты записи
+         */
+        std::span<const std::uint8_t> bytes() const { return bytes_; }
+
+        const_iterator begin() const {
+            return const_iterator(bytes_.data(), payload_.data(),
+                                  payload_.data() + payload_.size(), size_);
+        }
+        const_iterator end() const { return const_iterator(); }
+
+        /**
+         * @brief Декодировать коэффициенты в буфер вызывающего
+         * @param out Буфер (очищается, ёмкость переиспользуется)
+         * @return Представление над out, действительное до его изменения
+         * @throw ParseError При повреждённых данных
+         */
+        ContinuedFractionView decode_into(std::vector<long long>& out) const;
+
+        /**
+         * @brief Декодировать запись в цепную дробь
+         * @throw ParseError При повреждённых данных
+         */
+        ContinuedFraction decode() const;
+
+    private:
+        std::span<const std::uint8_t> bytes_;     ///< Вся запись
+        std::span<const std::uint8_t> payload_;   ///< Коэффициенты после заголовка
+        size_t size_;                             ///< Количество коэффициентов
+        size_t period_start_;                     ///< Начало периода или npos
+    };
+
+    // ==================== АРХИВ ====================
+
+    /**
+     * @class ArchiveWriter
+     * @brief Построение архива записей в памяти
+     */
+    class ArchiveWriter {
+    public:
+        ArchiveWriter() : offsets_{0} {}
+
+        /**
+         * @brief Добавить цепную дробь в архив
+         */
+        void add(const ContinuedFraction& cf);
+
+        /**
+         * @brief Количество добавленных записей
+         */
+        size_t size() const { return offsets_.size() - 1; }
+
+        /**
+         * @brief Собрать архив целиком
+         * @return Байты архива (заголовок, таблица смещений, данные)
+         */
+        std::vector<std::uint8_t> finish() const;
+
+        /**
+         * @brief Записать архив в файл
+         * @param path Путь к файлу
+         * @throw std::runtime_error При ошибке записи
+         */
+        void write_file(const std::string& path) const;
+
+    private:
+        std::vector<std::uint8_t> data_;       ///< Данные записей подряд
+        std::vector<std::uint64_t> offsets_;   ///< Смещения записей, offsets_[0] = 0
+    };
+
+    /**
+     * @class ArchiveView
+     * @brief Невладеющее представление архива над массивом байтов
+     *
+     * Проверяет заголовок и таблицу смещений целиком при создании;
+     * сами записи разбираются только при обращении к ним.
+     */
+    class ArchiveView {
+    public:
+        ArchiveView() : count_(0) {}
+
+        /**
+         * @brief Представление над байтами архива
+         * @throw ParseError При неверной сигнатуре, версии или таблице смещений
+         */
+        explicit ArchiveView(std::span<const std::uint8_t> bytes);
+
+        /**
+         * @brief Количество записей
+         */
+        size_t size() const { return count_; }
+
+        /**
+         * @brief Запись по индексу (без проверки индекса)
+         */
+        BinaryRecordView operator[](size_t index) const;
+
+        /**
+         * @brief Запись по индексу
+         * @throw std::out_of_range При index ≥ size()
+         */
+        BinaryRecordView at(size_t index) const;
+
+    private:
+        std::span<const std::uint8_t> offsets_;   ///< Таблица смещений (count_ + 1 значений)
+        std::span<const std::uint8_t> data_;      ///< Данные записей
+        size_t count_;                            ///< Количество записей
+
+        /**
+         * @brief i-е смещение из таблицы
+         */
+        std::uint64_t offset(size_t i) const;
+    };
+
+    /**
+     * @class MappedArchive
+     * @brief Архив, открытый только для чтения через отображение файла в память
+     *
+     * Файл не читается целиком: страницы подгружаются системой
+     * при обращении к конкретным записям.
+     */
+    class MappedArchive {
+    public:
+        /**
+         * @brief Открыть архив
+         * @param path Путь к файлу
+         * @throw std::runtime_error Если файл не удаётся открыть или отобразить
+         * @throw ParseError При неверном формате
+         */
+        explicit MappedArchive(const std::string& path);
+
+        ~MappedArchive();
+
+        MappedArchive(const MappedArchive&) = delete;
+        MappedArchive& operator=(const MappedArchive&) = delete;
+
+        MappedArchive(MappedArchive&& other) noexcept;
+        MappedArchive& operator=(MappedArchive&& other) noexcept;
+
+        /**
+         * @brief Представление архива
+         */
+        const ArchiveView& view() const { return view_; }
+
+        size_t size() const { return view_.size(); }
+        BinaryRecordView operator[](size_t index) const { return view_[index]; }
+        BinaryRecordView at(size_t index) const { return view_.at(index); }
+
+    private:
+        const std::uint8_t* data_;   ///< Начало отображения
+        size_t length_;              ///< Длина файла
+#ifdef _WIN32
+        void* file_;                 ///< HANDLE файла
+        void* mapping_;              ///< HANDLE отображения
+#endif
+        ArchiveView view_;           ///< Разобранный заголовок
+
+        /**
+         * @brief Снять отображение и закрыть дескрипторы
+         */
+        void release() noexcept;
+    };
+}
+
+#endif // BINARY_FORMAT_H
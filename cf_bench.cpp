@@ -0,0 +1,284 @@
+/**
+ * @file cf_bench.cpp
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Микробенчмарки горячих путей библиотеки (Google Benchmark)
+ *
+ * Каждый бенчмарк параметризован длиной дроби, поэтому регрессии видны
+ * и на коротких дробях во встроенном буфере, и на длинных. Результаты
+ * для сравнения между версиями сохраняются в JSON:
+ *
+ *   cf_bench --benchmark_format=json --benchmark_out=cf_bench.json
+ *
+ * Методы с кэшем (to_double, convergent) измеряются на свежей копии
+ * дроби, иначе после первой итерации измерялось бы только чтение кэша.
+ *
+ * Лицензия: MIT
+ */
+
+#include "continued_fraction.h"
+#include "lazy_continued_fraction.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace Math;
+
+namespace {
+    /**
+     * @brief Детерминированные коэффициенты [a₀; a₁, ...] с aᵢ ∈ [1, 16]
+     *
+     * Линейный конгруэнтный генератор: одинаковые входные данные между
+     * запусками при типичном для «случайных» чисел распределении.
+     */
+    std::vector<long long> make_coefficients(size_t count) {
+        std::vector<long long> coeffs;
+        coeffs.reserve(count);
+        std::uint64_t state = 0x9E3779B97F4A7C15ull;
+        for (size_t i = 0; i < count; ++i) {
+            state = state * 6364136223846793005ull + 1442695040888963407ull;
+            coeffs.push_back(static_cast<long long>((state >> 33) % 16) + 1);
+        }
+        return coeffs;
+    }
+
+    /**
+     * @brief Дробь длины count со случайными коэффициентами
+     */
+    ContinuedFraction make_fraction(size_t count) {
+        return ContinuedFraction(make_coefficients(count));
+    }
+
+    /**
+     * @brief Длины дробей: встроенный буфер, типичные и длинные дроби
+     */
+    void fraction_sizes(benchmark::internal::Benchmark* bench) {
+        bench->RangeMultiplier(8)->Range(4, 4096);
+    }
+
+    /**
+     * @brief Длины операндов арифметики (каждый коэффициент результата
+     *        требует нескольких шагов алгоритма Госпера; длина результата
+     *        ограничена result_terms, поэтому время растет не линейно)
+     */
+    void operand_sizes(benchmark::internal::Benchmark* bench) {
+        bench->RangeMultiplier(4)->Range(4, 256);
+    }
+
+    size_t size_arg(const benchmark::State& state) {
+        return static_cast<size_t>(state.range(0));
+    }
+}
+
+// ==================== ВЫЧИСЛЕНИЕ ЗНАЧЕНИЯ ====================
+
+static void BM_ToDouble(benchmark::State& state) {
+    const ContinuedFraction source = make_fraction(size_arg(state));
+    for (auto _ : state) {
+        state.PauseTiming();
+        ContinuedFraction cf = source;
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(cf.to_double());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ToDouble)->Apply(fraction_sizes);
+
+static void BM_ViewToDouble(benchmark::State& state) {
+    const ContinuedFraction cf = make_fraction(size_arg(state));
+    const ContinuedFractionView view = cf.view();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view.to_double());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ViewToDouble)->Apply(fraction_sizes);
+
+// ==================== ПОДХОДЯЩИЕ ДРОБИ ====================
+
+static void BM_Convergent(benchmark::State& state) {
+    // Подходящие дроби случайной дроби переполняют long long примерно
+    // после 30 коэффициентов, поэтому берется последняя представимая
+    const ContinuedFraction source = make_fraction(size_arg(state));
+    for (auto _ : state) {
+        state.PauseTiming();
+        ContinuedFraction cf = source;
+        state.ResumeTiming();
+        const size_t last = std::min<size_t>(cf.size(), 24) - 1;
+        benchmark::DoNotOptimize(cf.convergent(last));
+    }
+}
+BENCHMARK(BM_Convergent)->Apply(fraction_sizes);
+
+static void BM_ExactConvergent(benchmark::State& state) {
+    const ContinuedFraction cf = make_fraction(size_arg(state));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cf.exact_convergent(cf.size() - 1));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ExactConvergent)->Apply(fraction_sizes);
+
+// ==================== ПОСТРОЕНИЕ ДРОБИ ====================
+
+static void BM_AddCoefficient(benchmark::State& state) {
+    const std::vector<long long> coeffs = make_coefficients(size_arg(state));
+    for (auto _ : state) {
+        ContinuedFraction cf(coeffs.front());
+        for (size_t i = 1; i < coeffs.size(); ++i) {
+            cf.add_coefficient(coeffs[i]);
+        }
+        benchmark::DoNotOptimize(cf);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AddCoefficient)->Apply(fraction_sizes);
+
+static void BM_Normalize(benchmark::State& state) {
+    // Каждый восьмой коэффициент нулевой: нормализация схлопывает
+    // [..., a, 0, b, ...] в [..., a + b, ...]
+    std::vector<long long> coeffs = make_coefficients(size_arg(state));
+    for (size_t i = 7; i + 1 < coeffs.size(); i += 8) {
+        coeffs[i] = 0;
+    }
+    for (auto _ : state) {
+        ContinuedFraction cf(coeffs);
+        benchmark::DoNotOptimize(cf);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Normalize)->Apply(fraction_sizes);
+
+static void BM_FromRational(benchmark::State& state) {
+    // F(91)/F(90) - самое длинное разложение среди пар long long
+    long long a = 1, b = 1;
+    for (int i = 0; i < 89; ++i) {
+        const long long next = a + b;
+        a = b;
+        b = next;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ContinuedFraction::from_rational(b, a));
+    }
+}
+BENCHMARK(BM_FromRational);
+
+static void BM_FromDouble(benchmark::State& state) {
+    const double value = 3.14159265358979323846;
+    const size_t terms = size_arg(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(ContinuedFraction::from_double(value, terms));
+    }
+}
+BENCHMARK(BM_FromDouble)->Arg(4)->Arg(8)->Arg(20);
+
+// ==================== СТРОКОВОЕ ПРЕДСТАВЛЕНИЕ ====================
+
+static void BM_ToString(benchmark::State& state) {
+    const ContinuedFraction cf = make_fraction(size_arg(state));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cf.to_string());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ToString)->Apply(fraction_sizes);
+
+static void BM_ParseString(benchmark::State& state) {
+    const std::string text = make_fraction(size_arg(state)).to_string();
+    ContinuedFraction cf;
+    for (auto _ : state) {
+        cf.parse_string(text);
+        benchmark::DoNotOptimize(cf);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+}
+BENCHMARK(BM_ParseString)->Apply(fraction_sizes);
+
+// ==================== КВАДРАТНЫЕ КОРНИ ====================
+
+static void BM_SqrtContinuedFraction(benchmark::State& state) {
+    // Период √n длиннее max_terms, поэтому результат не кэшируется и
+    // каждая итерация разлагает корень заново
+    const long long n = 1000000000000037LL;
+    const size_t terms = size_arg(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqrt_continued_fraction(n, terms));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SqrtContinuedFraction)->Apply(fraction_sizes);
+
+static void BM_SqrtContinuedFractionCached(benchmark::State& state) {
+    const long long n = 1000003;
+    sqrt_continued_fraction(n);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sqrt_continued_fraction(n));
+    }
+}
+BENCHMARK(BM_SqrtContinuedFractionCached);
+
+// ==================== АРИФМЕТИКА ====================
+
+template <typename Operation>
+static void arithmetic_benchmark(benchmark::State& state, Operation operation) {
+    const std::vector<long long> coeffs = make_coefficients(2 * size_arg(state));
+    const ContinuedFraction a(std::vector<long long>(coeffs.begin(), coeffs.begin() + state.range(0)));
+    const ContinuedFraction b(std::vector<long long>(coeffs.begin() + state.range(0), coeffs.end()));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(operation(a, b));
+    }
+}
+
+static void BM_Add(benchmark::State& state) {
+    arithmetic_benchmark(state, [](const ContinuedFraction& a, const ContinuedFraction& b) {
+        return a + b;
+    });
+}
+BENCHMARK(BM_Add)->Apply(operand_sizes);
+
+static void BM_Subtract(benchmark::State& state) {
+    arithmetic_benchmark(state, [](const ContinuedFraction& a, const ContinuedFraction& b) {
+        return a - b;
+    });
+}
+BENCHMARK(BM_Subtract)->Apply(operand_sizes);
+
+static void BM_Multiply(benchmark::State& state) {
+    arithmetic_benchmark(state, [](const ContinuedFraction& a, const ContinuedFraction& b) {
+        return a * b;
+    });
+}
+BENCHMARK(BM_Multiply)->Apply(operand_sizes);
+
+static void BM_Divide(benchmark::State& state) {
+    arithmetic_benchmark(state, [](const ContinuedFraction& a, const ContinuedFraction& b) {
+        return a / b;
+    });
+}
+BENCHMARK(BM_Divide)->Apply(operand_sizes);
+
+static void BM_LazySum(benchmark::State& state) {
+    // √2 + e: бесконечные операнды, коэффициенты результата по запросу
+    const size_t terms = size_arg(state);
+    for (auto _ : state) {
+        const LazyContinuedFraction sum = lazy_sqrt_continued_fraction(2) + lazy_e_continued_fraction();
+        benchmark::DoNotOptimize(sum.take(terms));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LazySum)->Apply(operand_sizes);
+
+// ==================== СПЕЦИАЛЬНЫЕ КОНСТАНТЫ ====================
+
+static void BM_PiContinuedFraction(benchmark::State& state) {
+    const size_t terms = size_arg(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pi_continued_fraction(terms));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PiContinuedFraction)->Apply(operand_sizes);
+
+BENCHMARK_MAIN();
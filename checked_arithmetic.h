@@ -0,0 +1,186 @@
+/**
+ * @file checked_arithmetic.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Целочисленные операции с контролем переполнения
+ *
+ * Вспомогательные функции для алгоритмов, работающих с long long:
+ * на GCC/Clang используются встроенные __builtin_*_overflow,
+ * на остальных компиляторах - переносимая проверка границ.
+ * Все функции constexpr и доступны на этапе компиляции.
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef CHECKED_ARITHMETIC_H
+#define CHECKED_ARITHMETIC_H
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Math {
+    namespace detail {
+        /**
+         * @brief Сложение с проверкой переполнения
+         * @param a Первое слагаемое
+         * @param b Второе слагаемое
+         * @param result Результат (валиден только при возврате true)
+         * @return true, если переполнения не произошло
+         */
+        constexpr bool checked_add(long long a, long long b, long long& result) {
+#if defined(__GNUC__) || defined(__clang__)
+            return !__builtin_add_overflow(a, b, &result);
+#else
+            if ((b > 0 && a > std::numeric_limits<long long>::max() - b) ||
+                (b < 0 && a < std::numeric_limits<long long>::min() - b)) {
+                return false;
+            }
+            result = a + b;
+            return true;
+#endif
+        }
+
+        /**
+         * @brief Вычитание с проверкой переполнения
+         * @param a Уменьшаемое
+         * @param b Вычитаемое
+         * @param result Результат (валиден только при возврате true)
+         * @return true, если переполнения не произошло
+         */
+        constexpr bool checked_sub(long long a, long long b, long long& result) {
+#if defined(__GNUC__) || defined(__clang__)
+            return !__builtin_sub_overflow(a, b, &result);
+#else
+            if ((b < 0 && a > std::numeric_limits<long long>::max() + b) ||
+                (b > 0 && a < std::numeric_limits<long long>::min() + b)) {
+                return false;
+            }
+            result = a - b;
+            return true;
+#endif
+        }
+
+        /**
+         * @brief Умножение с проверкой переполнения
+         * @param a Первый множитель
+         * @param b Второй множитель
+         * @param result Результат (валиден только при возврате true)
+         * @return true, если переполнения не произошло
+         */
+        constexpr bool checked_mul(long long a, long long b, long long& result) {
+#if defined(__GNUC__) || defined(__clang__)
+            return !__builtin_mul_overflow(a, b, &result);
+#else
+            if (a == 0 || b == 0) {
+                result = 0;
+                return true;
+            }
+            constexpr long long max = std::numeric_limits<long long>::max();
+            constexpr long long min = std::numeric_limits<long long>::min();
+            if ((a == -1 && b == min) || (b == -1 && a == min)) {
+                return false;
+            }
+            if (a > 0 ? (b > 0 ? a > max / b : b < min / a)
+                      : (b > 0 ? a < min / b : a < max / b)) {
+                return false;
+            }
+            result = a * b;
+            return true;
+#endif
+        }
+
+        /**
+         * @brief Вычислить a·b + c с проверкой переполнения
+         * @param result Результат (валиден только при возврате true)
+         * @return true, если переполнения не произошло
+         */
+        constexpr bool checked_mul_add(long long a, long long b, long long c, long long& result) {
+#if defined(__SIZEOF_INT128__)
+            // Одно 128-битное выражение вместо двух проверок
+            __extension__ typedef __int128 wide_int;
+            const wide_int wide = static_cast<wide_int>(a) * b + c;
+            if (wide < std::numeric_limits<long long>::min() ||
+                wide > std::numeric_limits<long long>::max()) {
+                return false;
+            }
+            result = static_cast<long long>(wide);
+            return true;
+#else
+            long long product;
+            return checked_mul(a, b, product) && checked_add(product, c, result);
+#endif
+        }
+
+        /**
+         * @brief Вычислить a·b + c по модулю 2⁶⁴ (без неопределенного поведения)
+         */
+        constexpr long long wrapping_mul_add(long long a, long long b, long long c) {
+            return static_cast<long long>(static_cast<unsigned long long>(a) *
+                                          static_cast<unsigned long long>(b) +
+                                          static_cast<unsigned long long>(c));
+        }
+
+        /**
+         * @brief Вычислить a·b + c с проверкой переполнения
+         * @throw std::overflow_error При выходе за пределы long long
+         */
+        constexpr long long mul_add_or_throw(long long a, long long b, long long c) {
+            long long result;
+            if (!checked_mul_add(a, b, c, result)) {
+                throw std::overflow_error("Переполнение long long в целочисленной арифметике");
+            }
+            return result;
+        }
+
+        /**
+         * @brief Целочисленное деление с округлением вниз
+         * @param a Делимое
+         * @param b Делитель (не ноль)
+         * @return ⌊a / b⌋
+         */
+        constexpr long long floor_div(long long a, long long b) {
+            long long q = a / b;
+            if ((a % b != 0) && ((a < 0) != (b < 0))) {
+                --q;
+            }
+            return q;
+        }
+
+        /**
+         * @brief Целочисленный квадратный корень
+         *
+         * Начальное приближение берется из std::sqrt и уточняется
+         * целочисленно, поэтому результат точен и для n > 2⁵³.
+         * При вычислении на этапе компиляции std::sqrt недоступен,
+         * и корень находится целочисленным методом Ньютона.
+         *
+         * @param n Неотрицательное число
+         * @return ⌊√n⌋
+         */
+        constexpr long long isqrt(long long n) {
+            if (n < 2) {
+                return n;
+            }
+            if (std::is_constant_evaluated()) {
+                // Убывающая последовательность Ньютона, начиная с n/2 + 1 > √n
+                long long r = n / 2 + 1;
+                for (long long next = (r + n / r) / 2; next < r; next = (r + n / r) / 2) {
+                    r = next;
+                }
+                return r;
+            }
+            long long r = static_cast<long long>(std::sqrt(static_cast<double>(n)));
+            while (r > n / r) {
+                --r;
+            }
+            while (r + 1 <= n / (r + 1)) {
+                ++r;
+            }
+            return r;
+        }
+    }
+}
+
+#endif // CHECKED_ARITHMETIC_H
@@ -0,0 +1,468 @@
+/**
+ * @file coefficient_stream.cpp
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Реализация потокового чтения и записи цепных дробей
+ *
+ * Разбор - конечный автомат по символам, поэтому коэффициент или
+ * разделитель может быть разрезан границей блока. Грамматика и
+ * сообщения об ошибках совпадают с ContinuedFraction::parse_string().
+ */
+
+#include "coefficient_stream.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Math {
+    namespace {
+        bool is_space(char ch) {
+            return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+        }
+
+        bool is_digit(char ch) {
+            return ch >= '0' && ch <= '9';
+        }
+
+        size_t checked_chunk_size(size_t chunk_size) {
+            if (chunk_size == 0) {
+                throw std::invalid_argument("Размер блока должен быть положительным");
+            }
+            return chunk_size;
+        }
+    }
+
+    // ==================== ЧТЕНИЕ ====================
+
+    /**
+     * @brief Источник из буфера потока
+     *
+     * Сначала ждет хотя бы один символ, затем забирает только то, что
+     * уже лежит в буфере std::streambuf.
+     */
+    CoefficientStreamReader::CoefficientStreamReader(std::istream& is, size_t chunk_size)
+        : CoefficientStreamReader(
+              [&is](char* buffer, size_t size) -> size_t {
+                  std::streambuf* sb = is.rdbuf();
+                  if (sb == nullptr) {
+                      return 0;
+                  }
+                  std::streamsize available = sb->in_avail();
+                  if (available <= 0) {
+                      if (std::istream::traits_type::eq_int_type(sb->sgetc(),
+                                                                 std::istream::traits_type::eof())) {
+                          is.setstate(std::ios::eofbit);
+                          return 0;
+                      }
+                      available = std::max<std::streamsize>(sb->in_avail(), 1);
+                  }
+                  const std::streamsize wanted =
+                      std::min(available, static_cast<std::streamsize>(size));
+                  return static_cast<size_t>(sb->sgetn(buffer, wanted));
+              },
+              chunk_size) {}
+
+    /**
+     * @brief Источник из файлового дескриптора
+     */
+    CoefficientStreamReader::CoefficientStreamReader(int fd, size_t chunk_size)
+        : CoefficientStreamReader(
+              [fd](char* buffer, size_t size) -> size_t {
+                  while (true) {
+#ifdef _WIN32
+                      const int count = ::_read(fd, buffer,
+                                                static_cast<unsigned>(std::min<size_t>(size, INT_MAX)));
+#else
+                      const ssize_t count = ::read(fd, buffer, size);
+#endif
+                      if (count >= 0) {
+                          return static_cast<size_t>(count);
+                      }
+                      if (errno != EINTR) {
+                          throw std::system_error(errno, std::generic_category(),
+                                                  "Ошибка чтения цепной дроби");
+                      }
+                  }
+              },
+              chunk_size) {}
+
+    CoefficientStreamReader::CoefficientStreamReader(ChunkSource source, size_t chunk_size)
+        : source_(std::move(source))
+        , storage_(checked_chunk_size(chunk_size))
+        , buffer_(storage_) {}
+
+    CoefficientStreamReader::CoefficientStreamReader(ChunkSource source, std::span<char> buffer)
+        : source_(std::move(source))
+        , buffer_(buffer.first(checked_chunk_size(buffer.size()))) {}
+
+    /**
+     * @brief Следующий коэффициент
+     *
+     * Символ, завершивший коэффициент, остается в буфере и
+     * обрабатывается при следующем вызове.
+     */
+    bool CoefficientStreamReader::next(long long& coeff) {
+        restart_if_done();
+
+        while (true) {
+            if (begin_ == end_ && !refill()) {
+                if (state_ == State::Number) {
+                    finish_number();
+                    state_ = State::Separator;
+                }
+                consume('\0');   // Бросает ParseError: дробь не закрыта
+            }
+
+            const char ch = buffer_[begin_];
+            if (state_ == State::Number) {
+                if (extend_number(ch)) {
+                    ++begin_;
+                    ++position_;
+                    continue;
+                }
+                coeff = finish_number();
+                state_ = State::Separator;
+                ++terms_;
+                return true;
+            }
+
+            consume(ch);
+            if (state_ != State::Number) {
+                // Первый символ коэффициента разбирает extend_number()
+                ++begin_;
+                ++position_;
+            }
+            if (state_ == State::Done) {
+                return false;
+            }
+        }
+    }
+
+    /**
+     * @brief Дочитать дробь в построитель
+     */
+    size_t CoefficientStreamReader::read_into(ContinuedFraction::Builder& builder) {
+        size_t added = 0;
+        long long coeff;
+        while (next(coeff)) {
+            if (period_start_ == terms_ - 1) {
+                builder.begin_period();
+            }
+            builder.push_back(coeff);
+            ++added;
+        }
+        return added;
+    }
+
+    /**
+     * @brief Прочитать дробь
+     */
+    ContinuedFraction CoefficientStreamReader::read() {
+        restart_if_done();
+        ContinuedFraction::Builder builder;
+        read_into(builder);
+        return builder.finish();
+    }
+
+    /**
+     * @brief Пропустить пробелы между дробями
+     */
+    bool CoefficientStreamReader::at_end() {
+        restart_if_done();
+        while (true) {
+            while (begin_ < end_ && is_space(buffer_[begin_])) {
+                ++begin_;
+                ++position_;
+            }
+            if (begin_ < end_) {
+                return false;
+            }
+            if (!refill()) {
+                return true;
+            }
+        }
+    }
+
+    bool CoefficientStreamReader::refill() {
+        if (exhausted_) {
+            return false;
+        }
+        begin_ = 0;
+        end_ = source_(buffer_.data(), buffer_.size());
+        exhausted_ = end_ == 0;
+        return !exhausted_;
+    }
+
+    void CoefficientStreamReader::restart_if_done() {
+        if (state_ != State::Done) {
+            return;
+        }
+        state_ = State::Open;
+        offset_ += position_;
+        position_ = 0;
+        terms_ = 0;
+        period_start_ = ContinuedFraction::npos;
+        period_open_ = false;
+    }
+
+    /**
+     * @brief Переход автомата по символу разметки
+     */
+    void CoefficientStreamReader::consume(char ch) {
+        if (is_space(ch)) {
+            return;
+        }
+
+        switch (state_) {
+            case State::Open:
+                if (ch != '[') {
+                    fail("Ожидался символ '['", position_);
+                }
+                state_ = State::Term;
+                return;
+
+            case State::Term:
+                if (ch == '(' && period_start_ == ContinuedFraction::npos) {
+                    period_start_ = terms_;
+                    period_open_ = true;
+                    return;
+                }
+                if (!is_digit(ch) && ch != '+' && ch != '-') {
+                    fail("Ожидался целый коэффициент", position_);
+                }
+                state_ = State::Number;
+                number_start_ = position_;
+                number_length_ = 0;
+                number_overflow_ = false;
+                return;
+
+            case State::Separator:
+                if (ch == ')' && period_open_) {
+                    period_open_ = false;
+                    state_ = State::Close;
+                    return;
+                }
+                if (ch == ']') {
+                    if (period_open_) {
+                        fail("Не закрыта скобка периода", position_ + 1);
+                    }
+                    state_ = State::Done;
+                    return;
+                }
+                if (ch != ';' && ch != ',') {
+                    fail("Ожидался разделитель ';' или ','", position_);
+                }
+                state_ = State::Term;
+                return;
+
+            case State::Close:
+                if (ch != ']') {
+                    fail("Период должен завершать цепную дробь", position_);
+                }
+                state_ = State::Done;
+                return;
+
+            case State::Number:
+            case State::Done:
+                break;
+        }
+    }
+
+    /**
+     * @brief Накопление записи коэффициента
+     *
+     * Допускаются '+' и '-' в начале (как в parse_string()); незначащие
+     * нули отбрасываются, поэтому длина записи ограничена.
+     */
+    bool CoefficientStreamReader::extend_number(char ch) {
+        const bool after_plus = number_length_ == 1 && number_[0] == '+';
+        if (ch == '+' || ch == '-') {
+            if (number_length_ != 0 && !(ch == '-' && after_plus)) {
+                return false;
+            }
+            number_[number_length_++] = ch;
+            return true;
+        }
+        if (!is_digit(ch)) {
+            return false;
+        }
+
+        const bool last_is_zero = number_length_ > 0 && number_[number_length_ - 1] == '0';
+        const bool leading_zero = last_is_zero &&
+            (number_length_ == 1 || !is_digit(number_[number_length_ - 2]));
+        if (leading_zero) {
+            number_[number_length_ - 1] = ch;
+        } else if (number_length_ < sizeof(number_)) {
+            number_[number_length_++] = ch;
+        } else {
+            number_overflow_ = true;
+        }
+        return true;
+    }
+
+    long long CoefficientStreamReader::finish_number() {
+        if (number_overflow_) {
+            fail("Коэффициент вне диапазона long long", number_start_);
+        }
+
+        const char* first = number_;
+        const char* last = number_ + number_length_;
+        if (first != last && *first == '+') {
+            ++first;
+        }
+
+        long long value = 0;
+        const auto [ptr, ec] = std::from_chars(first, last, value);
+        if (ec == std::errc::result_out_of_range) {
+            fail("Коэффициент вне диапазона long long", number_start_);
+        }
+        if (ec != std::errc() || ptr != last) {
+            fail("Ожидался целый коэффициент", number_start_);
+        }
+        return value;
+    }
+
+    void CoefficientStreamReader::fail(const char* message, size_t position) const {
+        throw ParseError(std::string("Неверный формат цепной дроби: ") + message, position);
+    }
+
+    // ==================== ЗАПИСЬ ====================
+
+    CoefficientStreamWriter::CoefficientStreamWriter(std::ostream& os, size_t chunk_size)
+        : CoefficientStreamWriter(
+              [&os](const char* data, size_t size) {
+                  if (!os.write(data, static_cast<std::streamsize>(size))) {
+                      throw std::system_error(std::make_error_code(std::io_errc::stream),
+                                              "Ошибка записи цепной дроби");
+                  }
+              },
+              chunk_size) {}
+
+    CoefficientStreamWriter::CoefficientStreamWriter(int fd, size_t chunk_size)
+        : CoefficientStreamWriter(
+              [fd](const char* data, size_t size) {
+                  while (size > 0) {
+#ifdef _WIN32
+                      const int count = ::_write(fd, data,
+                                                 static_cast<unsigned>(std::min<size_t>(size, INT_MAX)));
+#else
+                      const ssize_t count = ::write(fd, data, size);
+#endif
+                      if (count < 0) {
+                          if (errno == EINTR) {
+                              continue;
+                          }
+                          throw std::system_error(errno, std::generic_category(),
+                                                  "Ошибка записи цепной дроби");
+                      }
+                      data += count;
+                      size -= static_cast<size_t>(count);
+                  }
+              },
+              chunk_size) {}
+
+    CoefficientStreamWriter::CoefficientStreamWriter(ChunkSink sink, size_t chunk_size)
+        : sink_(std::move(sink))
+        , chunk_size_(checked_chunk_size(chunk_size)) {
+        buffer_.reserve(chunk_size_);
+    }
+
+    CoefficientStreamWriter::~CoefficientStreamWriter() {
+        try {
+            flush();
+        } catch (...) {
+            // Деструктор не бросает; ошибку можно получить явным flush()
+        }
+    }
+
+    /**
+     * @brief Запись коэффициента с разделителем, как в format_to()
+     */
+    CoefficientStreamWriter& CoefficientStreamWriter::push_back(long long coeff) {
+        char term[32];   // "; (" и 20 знаков
+        char* out = term;
+        if (terms_ == 0) {
+            *out++ = '[';
+        } else {
+            *out++ = ';';
+            *out++ = ' ';
+        }
+        if (period_pending_) {
+            *out++ = '(';
+            period_pending_ = false;
+            period_start_ = terms_;
+        }
+        out = std::to_chars(out, term + sizeof(term), coeff).ptr;
+
+        append(std::string_view(term, static_cast<size_t>(out - term)));
+        ++terms_;
+        return *this;
+    }
+
+    CoefficientStreamWriter& CoefficientStreamWriter::begin_period() {
+        if (period_pending_ || period_start_ != ContinuedFraction::npos) {
+            throw std::logic_error("Период уже начат");
+        }
+        period_pending_ = true;
+        return *this;
+    }
+
+    CoefficientStreamWriter& CoefficientStreamWriter::end_fraction() {
+        if (period_pending_) {
+            throw std::logic_error("Период не может быть пустым");
+        }
+
+        if (terms_ == 0) {
+            append("[0]\n");
+        } else {
+            append(period_start_ != ContinuedFraction::npos ? ")]\n" : "]\n");
+        }
+        terms_ = 0;
+        period_start_ = ContinuedFraction::npos;
+        return *this;
+    }
+
+    /**
+     * @brief Запись дроби отдельной строкой
+     */
+    CoefficientStreamWriter& CoefficientStreamWriter::write(ContinuedFractionView view) {
+        if (terms_ != 0 || period_pending_) {
+            throw std::logic_error("Предыдущая дробь не завершена");
+        }
+
+        const std::span<const long long> coeffs = view.coefficients();
+        for (size_t i = 0; i < coeffs.size(); ++i) {
+            if (i == view.period_start()) {
+                begin_period();
+            }
+            push_back(coeffs[i]);
+        }
+        return end_fraction();
+    }
+
+    void CoefficientStreamWriter::flush() {
+        if (buffer_.empty()) {
+            return;
+        }
+        sink_(buffer_.data(), buffer_.size());
+        buffer_.clear();
+    }
+
+    void CoefficientStreamWriter::append(std::string_view text) {
+        buffer_.append(text);
+        if (buffer_.size() >= chunk_size_) {
+            flush();
+        }
+    }
+}
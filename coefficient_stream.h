@@ -0,0 +1,294 @@
+/**
+ * @file coefficient_stream.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Потоковое чтение и запись текстового представления цепных дробей
+ *
+ * Формат совпадает с to_string(): "[a0; a1, (a2, a3)]". Читатель
+ * запрашивает у источника (std::istream или файловый дескриптор)
+ * блоки фиксированного размера и выдает коэффициенты по мере
+ * разбора, не собирая строку целиком; писатель копит вывод в буфере
+ * того же размера. Расход памяти на разбор и вывод не зависит от
+ * длины дроби, а первый коэффициент доступен после первого блока.
+ *
+ *   CoefficientStreamReader reader(file);
+ *   long long coeff;
+ *   while (reader.next(coeff)) { ... }
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef COEFFICIENT_STREAM_H
+#define COEFFICIENT_STREAM_H
+
+#include "continued_fraction.h"
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Math {
+    /**
+     * @brief Размер блока чтения и записи по умолчанию
+     */
+    inline constexpr size_t DEFAULT_STREAM_CHUNK_SIZE = 64 * 1024;
+
+    /**
+     * @class CoefficientStreamReader
+     * @brief Инкрементальный разбор одной или нескольких дробей из потока
+     *
+     * Читатель может забрать у источника байты за концом текущей дроби;
+     * они остаются в его буфере, поэтому следующие дроби из того же
+     * источника нужно читать тем же читателем. Дроби разделяются
+     * пробельными символами (писатель ставит перевод строки).
+     *
+     * Ошибки формата сообщаются ParseError с позицией относительно
+     * начала дроби; ошибки ввода - std::system_error.
+     */
+    class CoefficientStreamReader {
+    public:
+        /**
+         * @brief Источник блоков: записать до size байт в buffer, вернуть
+         *        их количество (0 - конец данных)
+         */
+        using ChunkSource = std::function<size_t(char* buffer, size_t size)>;
+
+        /**
+         * @brief Чтение из std::istream
+         *
+         * Блок ограничен данными, уже доступными в буфере потока, поэтому
+         * чтение из канала не ждет заполнения всего блока.
+         */
+        explicit CoefficientStreamReader(std::istream& is,
+                                         size_t chunk_size = DEFAULT_STREAM_CHUNK_SIZE);
+
+        /**
+         * @brief Чтение из файлового дескриптора (дескриптор не закрывается)
+         */
+        explicit CoefficientStreamReader(int fd, size_t chunk_size = DEFAULT_STREAM_CHUNK_SIZE);
+
+        /**
+         * @brief Чтение из произвольного источника блоков
+         */
+        CoefficientStreamReader(ChunkSource source, size_t chunk_size);
+
+        /**
+         * @brief Чтение в буфер вызывающего
+         *
+         * Читатель не выделяет память под блок; буфер должен жить
+         * дольше читателя.
+         *
+         * @throw std::invalid_argument Если буфер пуст
+         */
+        CoefficientStreamReader(ChunkSource source, std::span<char> buffer);
+
+        CoefficientStreamReader(const CoefficientStreamReader&) = delete;
+        CoefficientStreamReader& operator=(const CoefficientStreamReader&) = delete;
+        CoefficientStreamReader(CoefficientStreamReader&&) = default;
+        CoefficientStreamReader& operator=(CoefficientStreamReader&&) = default;
+
+        /**
+         * @brief Следующий коэффициент текущей дроби
+         *
+         * После false следующий вызов начинает очередную дробь. После
+         * ParseError читатель использовать нельзя.
+         *
+         * @param coeff Прочитанный коэффициент
+         * @return false, если дробь закончилась (после ']')
+         * @throw ParseError При неверном формате или обрыве данных
+         */
+        bool next(long long& coeff);
+
+        /**
+         * @brief Принадлежит ли последний прочитанный коэффициент периоду
+         */
+        bool in_period() const noexcept { return period_start_ != ContinuedFraction::npos; }
+
+        /**
+         * @brief Индекс первого коэффициента периода или npos
+         */
+        size_t period_start() const noexcept { return period_start_; }
+
+        /**
+         * @brief Количество коэффициентов, прочитанных из текущей дроби
+         */
+        size_t terms() const noexcept { return terms_; }
+
+        /**
+         * @brief Смещение следующего неразобранного символа от начала данных
+         */
+        size_t offset() const noexcept { return offset_ + position_; }
+
+        /**
+         * @brief Дочитать текущую дробь в построитель
+         *
+         * Коэффициенты, уже полученные через next(), в построитель
+         * не попадают.
+         *
+         * @return Количество добавленных коэффициентов
+         * @throw ParseError При неверном формате или обрыве данных
+         */
+        size_t read_into(ContinuedFraction::Builder& builder);
+
+        /**
+         * @brief Прочитать следующую дробь целиком
+         * @throw ParseError При неверном формате или если данных нет
+         */
+        ContinuedFraction read();
+
+        /**
+         * @brief Остались ли во входных данных непробельные символы
+         *
+         * Вызывается между дробями; пропускает разделяющие пробелы.
+         */
+        bool at_end();
+
+    private:
+        /**
+         * @brief Состояние разбора
+         */
+        enum class State {
+            Open,         ///< Ожидается '['
+            Term,         ///< Ожидается коэффициент (или '(' перед ним)
+            Number,       ///< Внутри коэффициента
+            Separator,    ///< Ожидается ';', ',', ')' или ']'
+            Close,        ///< После ')' ожидается ']'
+            Done          ///< Дробь прочитана
+        };
+
+        /**
+         * @brief Наибольшая длина записи long long: знак и 19 цифр
+         */
+        static constexpr size_t MAX_NUMBER_LENGTH = 20;
+
+        ChunkSource source_;          ///< Источник данных
+        std::vector<char> storage_;   ///< Собственный блок (пуст при буфере вызывающего)
+        std::span<char> buffer_;      ///< Блок входных данных
+        size_t begin_ = 0;            ///< Первый неразобранный байт блока
+        size_t end_ = 0;              ///< Конец данных блока
+        bool exhausted_ = false;      ///< Источник вернул 0
+
+        State state_ = State::Open;   ///< Состояние разбора текущей дроби
+        size_t position_ = 0;         ///< Позиция от начала дроби
+        size_t offset_ = 0;           ///< Длина данных до начала текущей дроби
+        size_t number_start_ = 0;     ///< Позиция начала текущего коэффициента
+        char number_[MAX_NUMBER_LENGTH + 1];  ///< Накопленные знаки коэффициента ('+' допускается)
+        size_t number_length_ = 0;            ///< Длина number_
+        bool number_overflow_ = false;        ///< Значащих цифр больше, чем в long long
+        size_t terms_ = 0;                    ///< Прочитано коэффициентов
+        size_t period_start_ = ContinuedFraction::npos;   ///< Начало периода
+        bool period_open_ = false;            ///< Скобка периода открыта
+
+        /**
+         * @brief Запросить следующий блок
+         * @return false, если данные закончились
+         */
+        bool refill();
+
+        /**
+         * @brief Начать новую дробь, если предыдущая дочитана
+         */
+        void restart_if_done();
+
+        /**
+         * @brief Обработать символ вне коэффициента (EOF передается как '\0')
+         */
+        void consume(char ch);
+
+        /**
+         * @brief Добавить символ к коэффициенту
+         * @return false, если символ не входит в запись числа
+         */
+        bool extend_number(char ch);
+
+        /**
+         * @brief Завершить накопленный коэффициент
+         */
+        long long finish_number();
+
+        [[noreturn]] void fail(const char* message, size_t position) const;
+    };
+
+    /**
+     * @class CoefficientStreamWriter
+     * @brief Вывод дробей в формате to_string() блоками
+     *
+     * Каждая дробь завершается переводом строки, поэтому результат
+     * читается и CoefficientStreamReader, и operator>>. Буфер
+     * сбрасывается в приемник при заполнении, в flush() и в деструкторе.
+     */
+    class CoefficientStreamWriter {
+    public:
+        /**
+         * @brief Приемник блоков: записать size байт из data
+         */
+        using ChunkSink = std::function<void(const char* data, size_t size)>;
+
+        /**
+         * @brief Запись в std::ostream
+         * @throw std::system_error Если поток сообщает об ошибке при сбросе
+         */
+        explicit CoefficientStreamWriter(std::ostream& os,
+                                         size_t chunk_size = DEFAULT_STREAM_CHUNK_SIZE);
+
+        /**
+         * @brief Запись в файловый дескриптор (дескриптор не закрывается)
+         */
+        explicit CoefficientStreamWriter(int fd, size_t chunk_size = DEFAULT_STREAM_CHUNK_SIZE);
+
+        /**
+         * @brief Запись в произвольный приемник блоков
+         */
+        CoefficientStreamWriter(ChunkSink sink, size_t chunk_size);
+
+        /**
+         * @brief Сбросить буфер; ошибки сброса в деструкторе игнорируются
+         */
+        ~CoefficientStreamWriter();
+
+        CoefficientStreamWriter(const CoefficientStreamWriter&) = delete;
+        CoefficientStreamWriter& operator=(const CoefficientStreamWriter&) = delete;
+
+        /**
+         * @brief Записать коэффициент текущей дроби (первый открывает дробь)
+         */
+        CoefficientStreamWriter& push_back(long long coeff);
+
+        /**
+         * @brief Отметить, что следующие коэффициенты образуют период
+         * @throw std::logic_error Если период уже начат
+         */
+        CoefficientStreamWriter& begin_period();
+
+        /**
+         * @brief Завершить текущую дробь; дробь без коэффициентов пишется как [0]
+         * @throw std::logic_error Если период начат, но пуст
+         */
+        CoefficientStreamWriter& end_fraction();
+
+        /**
+         * @brief Записать дробь целиком
+         */
+        CoefficientStreamWriter& write(ContinuedFractionView view);
+
+        /**
+         * @brief Передать накопленный вывод приемнику
+         */
+        void flush();
+
+    private:
+        ChunkSink sink_;              ///< Приемник данных
+        std::string buffer_;          ///< Накопленный вывод
+        size_t chunk_size_;           ///< Порог сброса
+        size_t terms_ = 0;            ///< Записано коэффициентов текущей дроби
+        size_t period_start_ = ContinuedFraction::npos;   ///< Начало периода
+        bool period_pending_ = false; ///< begin_period() до очередного коэффициента
+
+        void append(std::string_view text);
+    };
+}
+
+#endif // COEFFICIENT_STREAM_H
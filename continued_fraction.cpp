@@ -10,8 +10,21 @@
  */
 
 #include "continued_fraction.h"
+#include "checked_arithmetic.h"
+#include "homographic.h"
+#include "instrumentation.h"
+#include "matrix_product.h"
+#include "pi_expansion.h"
+#include "sqrt_expansion.h"
+#include "static_continued_fraction.h"
 #include <algorithm>
+#include <charconv>
+#include <cmath>
 #include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 
 namespace Math {
     // ==================== РЕАЛИЗАЦИЯ ПРИВАТНЫХ МЕТОДОВ ====================
@@ -19,60 +32,77 @@ namespace Math {
     /**
      * @brief Нормализация коэффициентов цепной дроби
      *
-     * Выполняет:
-     * 1. Удаление нулевых коэффициентов (кроме первого)
-     * 2. Оптимизацию вида [..., a, 1, b] → [..., a+1, b]
-     * 3. Обновление флагов состояния
+     * Выполняет за один проход с уплотнением на месте:
+     * 1. Свертку нулевых коэффициентов (кроме первого):
+     *    [..., a, 0, b, ...] → [..., a+b, ...], так как a + 1/(0 + 1/(b + t)) = a + b + t
+     *    (ноль, получившийся при свертке, сворачивается дальше)
+     * 2. Удаление завершающего нуля
+     * 3. Инвалидацию кэша
+     *
+     * Коэффициенты периодической части не изменяются; ноль
+     * непосредственно перед периодом сохраняется.
      */
     void ContinuedFraction::normalize() {
-        // Удаление нулевых коэффициентов, кроме первого
-        if (coefficients_.size() > 1) {
-            auto it = std::remove_if(coefficients_.begin() + 1,
-                                    coefficients_.end(),
-                                    [](const Coefficient& c) {
-                                        return c.value == 0;
-                                    });
-            coefficients_.erase(it, coefficients_.end());
-        }
-
-        // Оптимизация: [..., a, 1, b] → [..., a+1, b]
-        for (size_t i = 0; i + 2 < coefficients_.size(); ++i) {
-            if (coefficients_[i + 1].value == 1 &&
-                !coefficients_[i + 1].is_negative &&
-                !coefficients_[i + 1].is_periodic_marker) {
-
-                // Вычисляем новый коэффициент
-                long long new_val = coefficients_[i].signed_value() +
-                                  coefficients_[i + 2].signed_value();
-                coefficients_[i] = Coefficient(new_val);
-
-                // Удаляем коэффициенты 1 и b
-                coefficients_.erase(coefficients_.begin() + i + 1,
-                                   coefficients_.begin() + i + 3);
-                --i; // Корректируем индекс после удаления
-            }
-        }
-
-        // Обновление состояния
-        update_flags();
-        invalidate_cache();
+        normalize_from(1);
     }
 
     /**
-     * @brief Обновление флагов состояния
+     * @brief Нормализация участка, начиная с first
+     * @param first Индекс первого ненормализованного коэффициента
      *
-     * Определяет, является ли дробь периодической и конечной
+     * Тот же однопроходный алгоритм, что и в normalize(), но
+     * коэффициенты до first не просматриваются.
+     *
+     * @return Наименьший индекс, коэффициент с которым мог измениться
      */
-    void ContinuedFraction::update_flags() {
-        // Проверяем наличие маркера начала периода
-        is_periodic_ = std::any_of(coefficients_.begin(),
-                                  coefficients_.end(),
-                                  [](const Coefficient& c) {
-                                      return c.is_periodic_marker;
-                                  });
+    size_t ContinuedFraction::normalize_from(size_t first) {
+        CF_INSTRUMENT_COUNT(Normalize);
+        CF_INSTRUMENT_TIMER(Normalize);
+
+        const size_t size = coefficients_.size();
+        const size_t limit = std::min(size, period_start_);
+        first = std::max<size_t>(first, 1);
+
+        size_t write = std::min(first, limit);
+        size_t lowest = write;
+        bool pending_zero = false;   // Ноль между coefficients_[write - 1] и следующим
+
+        for (size_t read = first; read < limit; ++read) {
+            const long long coeff = coefficients_[read];
+            if (pending_zero) {
+                lowest = std::min(lowest, write - 1);
+                if (!detail::checked_add(coefficients_[write - 1], coeff, coefficients_[write - 1])) {
+                    throw std::overflow_error("Переполнение long long при свертке нулевого коэффициента");
+                }
+                pending_zero = false;
+                if (coefficients_[write - 1] == 0 && write > 1) {
+                    --write;
+                    pending_zero = true;
+                }
+            } else if (coeff == 0) {
+                pending_zero = true;
+            } else {
+                coefficients_[write++] = coeff;
+            }
+        }
+
+        if (pending_zero && limit < size) {
+            coefficients_[write++] = 0;
+        }
+        pending_zero_ = pending_zero && limit == size;
+
+        // Сдвиг периодической части вслед за уплотненным префиксом
+        if (period_start_ != npos && limit < size) {
+            std::copy(coefficients_.begin() + limit, coefficients_.end(),
+                      coefficients_.begin() + write);
+            period_start_ = write;
+            write += size - limit;
+        }
+        coefficients_.resize(write);
+        CF_INSTRUMENT_COEFFICIENTS(write);
 
-        // Если есть период, дробь бесконечна
-        is_finite_ = !is_periodic_;
+        invalidate_cache();
+        return lowest;
     }
 
     /**
@@ -81,45 +111,120 @@ namespace Math {
      * Вызывается при изменении коэффициентов
      */
     void ContinuedFraction::invalidate_cache() const {
+        CF_INSTRUMENT_COUNT(CacheInvalidation);
         value_cached_ = false;
         cached_value_ = 0.0;
+        convergents_.clear();
+        convergent_overflow_ = npos;
+        hash_state_ = HASH_SEED;
+        hashed_terms_ = 0;
+        hash_cached_ = false;
+        forward_ = ForwardState();
     }
 
     /**
-     * @brief Вычисление n-й подходящей дроби
-     * @param n Индекс подходящей дроби
-     * @return Пару {числитель, знаменатель}
+     * @brief Коэффициент для рекуррентных формул
+     * @param i Индекс коэффициента
+     */
+    long long ContinuedFraction::coefficient_at(size_t i) const {
+        return view().coefficient_at(i);
+    }
+
+    /**
+     * @brief Дополнение кэша подходящих дробей
+     * @param n Индекс последней требуемой подходящей дроби
      *
      * Использует рекуррентные формулы:
      * p₋₁ = 1, p₀ = a₀, pᵢ = aᵢ·pᵢ₋₁ + pᵢ₋₂
      * q₋₁ = 0, q₀ = 1, qᵢ = aᵢ·qᵢ₋₁ + qᵢ₋₂
+     *
+     * Вычисление продолжается с последней закэшированной дроби,
+     * поэтому последовательные запросы стоят O(1) амортизированно.
+     * Каждый шаг проверяется на переполнение; кэш заканчивается первой
+     * переполненной дробью, индекс которой запоминается. Дальнейшие
+     * значения не кэшируются (см. wrapped_convergents), как и дроби
+     * периодической дроби дальше MAX_CHECKED_DEPTH, поэтому объем кэша
+     * ограничен.
      */
-    std::pair<long long, long long> ContinuedFraction::compute_convergent(size_t n) const {
-        // Базовый случай: нулевая подходящая дробь
-        if (n == 0) {
-            return {coefficients_[0].signed_value(), 1};
+    void ContinuedFraction::extend_convergents(size_t n) const {
+        if (period_start_ != npos) {
+            n = std::min(n, MAX_CHECKED_DEPTH - 1);
+        }
+        if (convergents_.size() > n || convergent_overflow_ != npos) {
+            return;
         }
 
-        // Инициализация по формулам
-        long long prev_num = coefficients_[0].signed_value();
-        long long prev_den = 1;
-        long long curr_num = coefficients_[0].signed_value() *
-                           coefficients_[1].signed_value() + 1;
-        long long curr_den = coefficients_[1].signed_value();
+        CF_INSTRUMENT_COUNT(ConvergentExtension);
+        CF_INSTRUMENT_TIMER(ConvergentExtension);
 
-        // Рекуррентное вычисление
-        for (size_t i = 2; i <= n; ++i) {
-            long long coeff = coefficients_[i % coefficients_.size()].signed_value();
-            long long new_num = coeff * curr_num + prev_num;
-            long long new_den = coeff * curr_den + prev_den;
+        if (convergents_.empty()) {
+            convergents_.emplace_back(coefficient_at(0), 1);
+            CF_INSTRUMENT_COUNT(ConvergentTerm);
+        }
+
+        for (size_t i = convergents_.size(); i <= n; ++i) {
+            const auto [prev_num, prev_den] = i >= 2
+                ? convergents_[i - 2]
+                : std::pair<long long, long long>{1, 0};
+            const auto [curr_num, curr_den] = convergents_[i - 1];
+            const long long coeff = coefficient_at(i);
+            CF_INSTRUMENT_COUNT(ConvergentTerm);
+
+            long long new_num;
+            long long new_den;
+            if (detail::checked_mul_add(coeff, curr_num, prev_num, new_num) &&
+                detail::checked_mul_add(coeff, curr_den, prev_den, new_den)) {
+                convergents_.emplace_back(new_num, new_den);
+                continue;
+            }
 
-            prev_num = curr_num;
-            prev_den = curr_den;
-            curr_num = new_num;
-            curr_den = new_den;
+            convergent_overflow_ = i;
+            convergents_.emplace_back(detail::wrapping_mul_add(coeff, curr_num, prev_num),
+                                      detail::wrapping_mul_add(coeff, curr_den, prev_den));
+            return;
         }
+    }
 
-        return {curr_num, curr_den};
+    /**
+     * @brief Подходящие дроби за концом кэша (по модулю 2⁶⁴)
+     *
+     * Продолжает рекурсию от двух последних закэшированных дробей
+     * и передает func(i, {pᵢ, qᵢ}) для i ∈ [convergents_.size(), end).
+     */
+    template <typename Func>
+    void ContinuedFraction::wrapped_convergents(size_t end, Func&& func) const {
+        std::pair<long long, long long> prev = convergents_.size() >= 2
+            ? convergents_[convergents_.size() - 2]
+            : std::pair<long long, long long>{1, 0};
+        std::pair<long long, long long> curr = convergents_.back();
+
+        for (size_t i = convergents_.size(); i < end; ++i) {
+            const long long coeff = coefficient_at(i);
+            const std::pair<long long, long long> next{
+                detail::wrapping_mul_add(coeff, curr.first, prev.first),
+                detail::wrapping_mul_add(coeff, curr.second, prev.second)};
+            prev = curr;
+            curr = next;
+            func(i, curr);
+        }
+    }
+
+    /**
+     * @brief Вычисление n-й подходящей дроби
+     * @param n Индекс подходящей дроби
+     * @return Пару {числитель, знаменатель}
+     */
+    std::pair<long long, long long> ContinuedFraction::compute_convergent(size_t n) const {
+        extend_convergents(n);
+        if (n < convergents_.size()) {
+            return convergents_[n];
+        }
+
+        std::pair<long long, long long> result;
+        wrapped_convergents(n + 1, [&](size_t, const std::pair<long long, long long>& value) {
+            result = value;
+        });
+        return result;
     }
 
     // ==================== РЕАЛИЗАЦИЯ КОНСТРУКТОРОВ ====================
@@ -130,36 +235,55 @@ namespace Math {
      * Создает цепную дробь [0]
      */
     ContinuedFraction::ContinuedFraction()
-        : coefficients_{Coefficient(0)}
-        , is_finite_(true)
-        , is_periodic_(false)
-        , cached_value_(0.0)
-        , value_cached_(false) {}
+        : ContinuedFraction(allocator_type()) {}
+
+    /**
+     * @brief Дробь [0] с распределителем
+     * @param alloc Распределитель памяти
+     */
+    ContinuedFraction::ContinuedFraction(const allocator_type& alloc)
+        : ContinuedFraction(0LL, alloc) {}
 
     /**
      * @brief Конструктор из целого числа
      * @param value Целое число
+     * @param alloc Распределитель памяти
      */
-    ContinuedFraction::ContinuedFraction(long long value)
-        : coefficients_{Coefficient(value)}
-        , is_finite_(true)
-        , is_periodic_(false)
+    ContinuedFraction::ContinuedFraction(long long value, const allocator_type& alloc)
+        : coefficients_(1, value, alloc)
+        , period_start_(npos)
         , cached_value_(static_cast<double>(value))
-        , value_cached_(true) {}
+        , value_cached_(true)
+        , convergents_(alloc)
+        , convergent_overflow_(npos) {}
 
     /**
      * @brief Конструктор из вектора коэффициентов
      * @param coeffs Вектор коэффициентов
+     * @param alloc Распределитель памяти
      */
-    ContinuedFraction::ContinuedFraction(const std::vector<long long>& coeffs)
-        : is_finite_(true)
-        , is_periodic_(false)
-        , cached_value_(0.0)
-        , value_cached_(false) {
+    ContinuedFraction::ContinuedFraction(const std::vector<long long>& coeffs,
+                                         const allocator_type& alloc)
+        : ContinuedFraction(Coefficients(coeffs.begin(), coeffs.end(), alloc), npos) {}
 
-        coefficients_.reserve(coeffs.size());
-        for (long long c : coeffs) {
-            coefficients_.emplace_back(c);
+    /**
+     * @brief Конструктор из готового буфера
+     * @param coeffs Буфер коэффициентов (задает и распределитель)
+     * @param period_start Начало периода
+     */
+    ContinuedFraction::ContinuedFraction(Coefficients&& coeffs, size_t period_start)
+        : coefficients_(std::move(coeffs))
+        , period_start_(period_start)
+        , cached_value_(0.0)
+        , value_cached_(false)
+        , convergents_(coefficients_.get_allocator())
+        , convergent_overflow_(npos) {
+        if (coefficients_.empty()) {
+            coefficients_.push_back(0);
+            period_start_ = npos;
+        }
+        if (period_start_ >= coefficients_.size()) {
+            period_start_ = npos;
         }
         normalize();
     }
@@ -167,12 +291,61 @@ namespace Math {
     /**
      * @brief Конструктор из строки
      * @param str Строковое представление
+     * @param alloc Распределитель памяти
      * @throw std::invalid_argument при неверном формате
      */
-    ContinuedFraction::ContinuedFraction(const std::string& str) {
+    ContinuedFraction::ContinuedFraction(const std::string& str, const allocator_type& alloc)
+        : coefficients_(alloc)
+        , period_start_(npos)
+        , convergents_(alloc) {
         parse_string(str);
     }
 
+    /**
+     * @brief Конструктор из представления
+     * @param view Невладеющее представление
+     * @param alloc Распределитель памяти
+     */
+    ContinuedFraction::ContinuedFraction(ContinuedFractionView view, const allocator_type& alloc)
+        : ContinuedFraction(Coefficients(view.coefficients().begin(), view.coefficients().end(), alloc),
+                            view.period_start()) {}
+
+    /**
+     * @brief Копирование с распределителем
+     *
+     * Кэши копируются вместе с коэффициентами.
+     */
+    ContinuedFraction::ContinuedFraction(const ContinuedFraction& other, const allocator_type& alloc)
+        : coefficients_(other.coefficients_, alloc)
+        , period_start_(other.period_start_)
+        , cached_value_(other.cached_value_)
+        , value_cached_(other.value_cached_)
+        , convergents_(other.convergents_, alloc)
+        , convergent_overflow_(other.convergent_overflow_)
+        , hash_state_(other.hash_state_)
+        , hashed_terms_(other.hashed_terms_)
+        , cached_hash_(other.cached_hash_)
+        , hash_cached_(other.hash_cached_)
+        , forward_(other.forward_)
+        , pending_zero_(other.pending_zero_) {}
+
+    /**
+     * @brief Перемещение с распределителем
+     */
+    ContinuedFraction::ContinuedFraction(ContinuedFraction&& other, const allocator_type& alloc)
+        : coefficients_(std::move(other.coefficients_), alloc)
+        , period_start_(other.period_start_)
+        , cached_value_(other.cached_value_)
+        , value_cached_(other.value_cached_)
+        , convergents_(std::move(other.convergents_), alloc)
+        , convergent_overflow_(other.convergent_overflow_)
+        , hash_state_(other.hash_state_)
+        , hashed_terms_(other.hashed_terms_)
+        , cached_hash_(other.cached_hash_)
+        , hash_cached_(other.hash_cached_)
+        , forward_(other.forward_)
+        , pending_zero_(other.pending_zero_) {}
+
     // ==================== РЕАЛИЗАЦИЯ ОСНОВНЫХ МЕТОДОВ ====================
 
     /**
@@ -180,12 +353,7 @@ namespace Math {
      * @return Вектор коэффициентов со знаками
      */
     std::vector<long long> ContinuedFraction::get_coefficients() const {
-        std::vector<long long> result;
-        result.reserve(coefficients_.size());
-        for (const auto& coeff : coefficients_) {
-            result.push_back(coeff.signed_value());
-        }
-        return result;
+        return coefficients_.to_vector();
     }
 
     /**
@@ -193,11 +361,11 @@ namespace Math {
      * @param coeffs Новые коэффициенты
      */
     void ContinuedFraction::set_coefficients(const std::vector<long long>& coeffs) {
-        coefficients_.clear();
-        coefficients_.reserve(coeffs.size());
-        for (long long c : coeffs) {
-            coefficients_.emplace_back(c);
+        coefficients_.assign(coeffs.begin(), coeffs.end());
+        if (coefficients_.empty()) {
+            coefficients_.push_back(0);
         }
+        period_start_ = npos;
         normalize();
     }
 
@@ -206,43 +374,194 @@ namespace Math {
      * @param coeff Новый коэффициент
      */
     void ContinuedFraction::add_coefficient(long long coeff) {
-        coefficients_.emplace_back(coeff);
-        normalize();
+        if (period_start_ != npos) {
+            // Удлинение периода меняет все последующие коэффициенты
+            coefficients_.push_back(coeff);
+            invalidate_cache();
+            return;
+        }
+
+        if (coeff == 0 || pending_zero_) {
+            // Ноль сворачивается со следующим коэффициентом
+            append_range(std::span<const long long>(&coeff, 1));
+            return;
+        }
+
+        // Хвост [..., a] + b уже нормализован; подходящие дроби,
+        // состояние хеша и прямого вычисления значения остаются верными
+        coefficients_.push_back(coeff);
+        value_cached_ = false;
+        hash_cached_ = false;
+    }
+
+    /**
+     * @brief Добавить несколько коэффициентов
+     * @param coeffs Добавляемые коэффициенты
+     */
+    void ContinuedFraction::append_range(std::span<const long long> coeffs) {
+        if (coeffs.empty()) {
+            return;
+        }
+
+        const size_t old_size = coefficients_.size();
+        if (pending_zero_) {
+            // Ноль, отброшенный предыдущим добавлением
+            coefficients_.push_back(0);
+        }
+        coefficients_.insert(coefficients_.end(), coeffs.begin(), coeffs.end());
+
+        if (period_start_ != npos) {
+            invalidate_cache();
+            return;
+        }
+
+        // Свертка меняет коэффициенты начиная с old_size - 1 (и раньше,
+        // только если свертка дала новый ноль); подходящие дроби,
+        // состояние хеша и прямого вычисления до этого индекса остаются верными
+        decltype(convergents_) prefix(convergents_.get_allocator());
+        prefix.swap(convergents_);
+        const size_t overflow = convergent_overflow_;
+        const std::uint64_t hash_state = hash_state_;
+        const size_t hashed_terms = hashed_terms_;
+        const ForwardState forward = forward_;
+
+        const size_t lowest = normalize_from(old_size);
+
+        const size_t kept = std::min(prefix.size(), lowest);
+        if (kept > 0) {
+            prefix.resize(kept);
+            convergents_.swap(prefix);
+            convergent_overflow_ = overflow < kept ? overflow : npos;
+        }
+        if (hashed_terms <= lowest) {
+            hash_state_ = hash_state;
+            hashed_terms_ = hashed_terms;
+        }
+        if (forward.terms <= lowest) {
+            forward_ = forward;
+        }
+    }
+
+    // ==================== ПОСТРОИТЕЛЬ ====================
+
+    ContinuedFraction::Builder::Builder(size_t expected_terms)
+        : period_start_(npos) {
+        coefficients_.reserve(expected_terms);
+    }
+
+    ContinuedFraction::Builder& ContinuedFraction::Builder::reserve(size_t expected_terms) {
+        coefficients_.reserve(expected_terms);
+        return *this;
+    }
+
+    ContinuedFraction::Builder& ContinuedFraction::Builder::push_back(long long coeff) {
+        coefficients_.push_back(coeff);
+        return *this;
+    }
+
+    ContinuedFraction::Builder& ContinuedFraction::Builder::append(std::span<const long long> coeffs) {
+        coefficients_.insert(coefficients_.end(), coeffs.begin(), coeffs.end());
+        return *this;
+    }
+
+    ContinuedFraction::Builder& ContinuedFraction::Builder::begin_period() {
+        period_start_ = coefficients_.size();
+        return *this;
+    }
+
+    ContinuedFraction::Builder& ContinuedFraction::Builder::cancel_period() {
+        period_start_ = npos;
+        return *this;
+    }
+
+    /**
+     * @brief Построение дроби: буфер перемещается, нормализация однократная
+     */
+    ContinuedFraction ContinuedFraction::Builder::finish() {
+        const Coefficients::allocator_type alloc = coefficients_.get_allocator();
+        ContinuedFraction result(std::move(coefficients_), period_start_);
+        coefficients_ = Coefficients(alloc);
+        period_start_ = npos;
+        return result;
     }
 
     /**
      * @brief Преобразовать в double
      * @return Числовое значение дроби
      *
-     * Использует кэширование для оптимизации
+     * Конечная регулярная дробь вычисляется вперед по рекуррентным
+     * формулам в long double (см. ForwardState); состояние сохраняется
+     * между вызовами, поэтому после добавления коэффициентов
+     * обрабатываются только новые. Когда соседние подходящие дроби
+     * отличаются меньше чем на 2⁻⁶⁴ относительно значения, дальнейшие
+     * коэффициенты на double не влияют, и для них проверяется только
+     * регулярность. Нерегулярные и периодические дроби вычисляются
+     * через ContinuedFractionView::to_double().
      */
     double ContinuedFraction::to_double() const {
+        CF_INSTRUMENT_COUNT(ToDoubleCall);
         if (value_cached_) {
             return cached_value_;
         }
 
-        if (coefficients_.empty()) {
-            cached_value_ = 0.0;
-            value_cached_ = true;
-            return cached_value_;
-        }
+        CF_INSTRUMENT_COUNT(ToDoubleMiss);
+        CF_INSTRUMENT_TIMER(ToDoubleMiss);
+
+        double value;
+        if (period_start_ != npos) {
+            value = view().to_double();
+        } else {
+            // Последний коэффициент может измениться при добавлении,
+            // поэтому в состояние входят только коэффициенты до него
+            const size_t interior = coefficients_.size() - 1;
+            ForwardState& state = forward_;
+            for (; state.terms < interior && state.regular; ++state.terms) {
+                const long long coeff = coefficients_[state.terms];
+                if (state.terms > 0 && coeff <= 0) {
+                    state.regular = false;
+                    break;
+                }
+                if (!state.converged) {
+                    state.push(coeff);
+                }
+            }
 
-        // Вычисление значения с конца для численной устойчивости
-        double value = 0.0;
-        for (auto it = coefficients_.rbegin(); it != coefficients_.rend(); ++it) {
-            if (value == 0.0) {
-                value = static_cast<double>(it->signed_value());
+            const long long last = coefficients_.back();
+            if (!state.regular || (interior > 0 && last <= 0)) {
+                value = view().to_double();
+            } else if (state.converged) {
+                value = static_cast<double>(state.p / state.q);
             } else {
-                value = static_cast<double>(it->signed_value()) + 1.0 / value;
+                const long double coeff = static_cast<long double>(last);
+                value = static_cast<double>((coeff * state.p + state.p_prev) /
+                                            (coeff * state.q + state.q_prev));
             }
         }
 
-        // Кэширование результата
         cached_value_ = value;
         value_cached_ = true;
         return cached_value_;
     }
 
+    /**
+     * @brief Шаг рекуррентных формул и проверка сходимости
+     *
+     * |pₖ/qₖ - pₖ₋₁/qₖ₋₁| = 1/(qₖ·qₖ₋₁), и значение регулярной дроби
+     * лежит между соседними подходящими дробями.
+     */
+    void ContinuedFraction::ForwardState::push(long long coeff) {
+        const long double a = static_cast<long double>(coeff);
+        const long double new_p = a * p + p_prev;
+        const long double new_q = a * q + q_prev;
+        p_prev = p; q_prev = q;
+        p = new_p; q = new_q;
+
+        constexpr long double TOLERANCE = 0x1p-64L;
+        if (q_prev > 0 && std::fabs(p) * q_prev * TOLERANCE >= 1.0L) {
+            converged = true;
+        }
+    }
+
     /**
      * @brief Получить подходящую дробь
      * @param n Индекс подходящей дроби
@@ -250,46 +569,440 @@ namespace Math {
      * @throw std::out_of_range при недопустимом индексе
      */
     std::pair<long long, long long> ContinuedFraction::convergent(size_t n) const {
-        if (n >= coefficients_.size() && is_finite_) {
+        if (n >= coefficients_.size() && period_start_ == npos) {
             throw std::out_of_range("Индекс подходящей дроби вне диапазона");
         }
         return compute_convergent(n);
     }
 
+    /**
+     * @brief Получить диапазон подходящих дробей
+     * @param begin Индекс первой подходящей дроби
+     * @param end Индекс за последней подходящей дробью
+     * @return Пары {числитель, знаменатель}
+     * @throw std::out_of_range при недопустимых индексах
+     */
+    std::vector<std::pair<long long, long long>>
+    ContinuedFraction::convergents(size_t begin, size_t end) const {
+        if (begin > end || (end > coefficients_.size() && period_start_ == npos)) {
+            throw std::out_of_range("Диапазон подходящих дробей вне границ");
+        }
+        if (begin == end) {
+            return {};
+        }
+
+        extend_convergents(end - 1);
+        const size_t cached = std::min(end, convergents_.size());
+        std::vector<std::pair<long long, long long>> result;
+        result.reserve(end - begin);
+        if (begin < cached) {
+            result.assign(convergents_.begin() + begin, convergents_.begin() + cached);
+        }
+        wrapped_convergents(end, [&](size_t i, const std::pair<long long, long long>& value) {
+            if (i >= begin) {
+                result.push_back(value);
+            }
+        });
+        return result;
+    }
+
+    /**
+     * @brief Подходящая дробь с контролем переполнения
+     * @param n Индекс подходящей дроби
+     * @return Пару {числитель, знаменатель}
+     * @throw std::out_of_range при недопустимом индексе
+     * @throw std::overflow_error если значение не помещается в long long
+     */
+    std::pair<long long, long long> ContinuedFraction::checked_convergent(size_t n) const {
+        std::pair<long long, long long> result = convergent(n);
+        if (convergent_overflow_ != npos && n >= convergent_overflow_) {
+            throw std::overflow_error("Переполнение long long в подходящей дроби с индексом " +
+                                      std::to_string(convergent_overflow_));
+        }
+        if (n >= convergents_.size()) {
+            // За пределом кэша периодической дроби переполнение не отслеживается
+            const auto [p, q] = exact_convergent(n);
+            if (!p.to_int64() || !q.to_int64()) {
+                throw std::overflow_error("Переполнение long long в подходящей дроби с индексом " +
+                                          std::to_string(n));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Глубина, до которой подходящие дроби точны
+     * @return Индекс первой переполненной подходящей дроби
+     */
+    size_t ContinuedFraction::safe_convergent_depth() const {
+        const size_t limit = period_start_ == npos ? coefficients_.size() : MAX_CHECKED_DEPTH;
+        for (size_t i = 0; i < limit; ++i) {
+            extend_convergents(i);
+            if (convergent_overflow_ != npos) {
+                return convergent_overflow_;
+            }
+        }
+        return limit;
+    }
+
+    namespace {
+        /**
+         * @brief Сравнение регулярных цепных дробей по коэффициентам
+         *
+         * Значения сравниваются по первому различающемуся коэффициенту:
+         * при четном индексе больший коэффициент дает большее значение,
+         * при нечетном - меньшее. Отсутствующий коэффициент считается
+         * бесконечным. Завершенная последовательность сначала приводится
+         * к каноническому виду [..., a, 1] → [..., a + 1], обрезанная - нет.
+         *
+         * @return Отрицательное, ноль или положительное число
+         */
+        int compare_expansions(std::vector<long long> u, bool u_complete,
+                               std::vector<long long> v, bool v_complete) {
+            for (auto [terms, complete] : {std::pair{&u, u_complete}, std::pair{&v, v_complete}}) {
+                if (complete && terms->size() > 1 && terms->back() == 1) {
+                    terms->pop_back();
+                    ++terms->back();
+                }
+            }
+
+            for (size_t j = 0; j < std::max(u.size(), v.size()); ++j) {
+                int order;
+                if (j >= u.size()) {
+                    order = 1;
+                } else if (j >= v.size()) {
+                    order = -1;
+                } else if (u[j] != v[j]) {
+                    order = u[j] < v[j] ? -1 : 1;
+                } else {
+                    continue;
+                }
+                return j % 2 == 0 ? order : -order;
+            }
+            return 0;
+        }
+
+        /**
+         * @brief Правило половины для промежуточной дроби с t = aᵢ / 2
+         *
+         * Промежуточная дробь (t·pᵢ₋₁ + pᵢ₋₂)/(t·qᵢ₋₁ + qᵢ₋₂) при t = aᵢ / 2
+         * ближе к x, чем pᵢ₋₁/qᵢ₋₁, тогда и только тогда, когда
+         * qᵢ₋₁/qᵢ₋₂ = [aᵢ₋₁; aᵢ₋₂, ..., a₁] < [aᵢ₊₁; aᵢ₊₂, ...].
+         * Для сравнения достаточно i коэффициентов хвоста.
+         */
+        bool half_rule_holds(const ContinuedFractionView& cf, size_t i) {
+            std::vector<long long> reversed;
+            for (size_t k = i - 1; k >= 1; --k) {
+                reversed.push_back(cf.coefficient_at(k));
+            }
+
+            std::vector<long long> tail;
+            size_t k = i + 1;
+            for (; k <= 2 * i && (cf.is_periodic() || k < cf.size()); ++k) {
+                tail.push_back(cf.coefficient_at(k));
+            }
+            const bool tail_complete = cf.is_finite() && k >= cf.size();
+
+            return compare_expansions(std::move(reversed), true, std::move(tail), tail_complete) < 0;
+        }
+    }
+
+    /**
+     * @brief Наилучшее рациональное приближение
+     *
+     * Подходящие дроби перебираются, пока знаменатель qₖ₊₁ = aₖ₊₁·qₖ + qₖ₋₁
+     * не превысит предел. Тогда наибольшая допустимая промежуточная дробь
+     * имеет t = ⌊(max_denominator - qₖ₋₁) / qₖ⌋ < aₖ₊₁; она лучше pₖ/qₖ
+     * при 2t > aₖ₊₁, а при 2t = aₖ₊₁ - по правилу половины.
+     */
+    std::pair<long long, long long> ContinuedFraction::best_rational(long long max_denominator) const {
+        if (max_denominator < 1) {
+            throw std::invalid_argument("Наибольший знаменатель должен быть положительным");
+        }
+
+        const ContinuedFractionView cf = view();
+        long long prev_num = 1, prev_den = 0;
+        long long curr_num = cf.coefficient_at(0), curr_den = 1;
+
+        for (size_t i = 1; cf.is_periodic() || i < cf.size(); ++i) {
+            const long long coeff = cf.coefficient_at(i);
+            if (coeff <= 0) {
+                throw std::invalid_argument("Наилучшее приближение определено только для регулярной дроби");
+            }
+
+            // Наибольшее t с t·qₖ + qₖ₋₁ ≤ max_denominator
+            const long long limit = (max_denominator - prev_den) / curr_den;
+            const long long t = std::min(limit, coeff);
+            const bool last = limit < coeff;
+            if (last && (limit < coeff - limit ||
+                         (limit == coeff - limit && !half_rule_holds(cf, i)))) {
+                return {curr_num, curr_den};
+            }
+
+            long long new_num;
+            if (!detail::checked_mul_add(t, curr_num, prev_num, new_num)) {
+                throw std::overflow_error("Числитель наилучшего приближения не помещается в long long");
+            }
+            const long long new_den = t * curr_den + prev_den;
+            if (last) {
+                return {new_num, new_den};
+            }
+            prev_num = curr_num; prev_den = curr_den;
+            curr_num = new_num; curr_den = new_den;
+        }
+        return {curr_num, curr_den};
+    }
+
+    /**
+     * @brief Подходящая дробь произвольной точности
+     * @param n Индекс подходящей дроби
+     * @return Пару {числитель, знаменатель}
+     * @throw std::out_of_range при недопустимом индексе
+     *
+     * Те же рекуррентные формулы, что и в extend_convergents,
+     * вычисляемые в BigInt. Начиная с TREE_CONVERGENT_THRESHOLD
+     * коэффициентов числа становятся длинными, и подходящая дробь
+     * вычисляется деревом произведений матриц (tree_convergent).
+     */
+    std::pair<BigInt, BigInt> ContinuedFraction::exact_convergent(size_t n) const {
+        if (n >= coefficients_.size() && period_start_ == npos) {
+            throw std::out_of_range("Индекс подходящей дроби вне диапазона");
+        }
+        if (n >= TREE_CONVERGENT_THRESHOLD) {
+            return tree_convergent(view(), n, 1);
+        }
+
+        BigInt prev_num = 1;
+        BigInt prev_den = 0;
+        BigInt curr_num = coefficient_at(0);
+        BigInt curr_den = 1;
+
+        for (size_t i = 1; i <= n; ++i) {
+            const BigInt coeff = coefficient_at(i);
+            BigInt new_num = coeff * curr_num + prev_num;
+            BigInt new_den = coeff * curr_den + prev_den;
+            prev_num = std::move(curr_num);
+            prev_den = std::move(curr_den);
+            curr_num = std::move(new_num);
+            curr_den = std::move(new_den);
+        }
+
+        return {std::move(curr_num), std::move(curr_den)};
+    }
+
     /**
      * @brief Упростить цепную дробь
      */
     void ContinuedFraction::simplify() {
+        canonicalize();
+    }
+
+    // ==================== КАНОНИЧЕСКИЙ ВИД И ХЕШ ====================
+
+    /**
+     * @brief Приведение к каноническому виду
+     *
+     * После нормализации конечная дробь [..., a, 1] заменяется на
+     * [..., a + 1]. У периодической дроби период сокращается до
+     * наименьшего (наименьший делитель d длины периода, с которым
+     * период d-периодичен), а затем начало периода сдвигается влево,
+     * пока коэффициент перед периодом совпадает с последним
+     * коэффициентом периода: [..., x, (p₁, ..., pᵣ₋₁, x)] → [..., (x, p₁, ..., pᵣ₋₁)].
+     */
+    void ContinuedFraction::canonicalize() {
         normalize();
+
+        const size_t size = coefficients_.size();
+        if (period_start_ == npos) {
+            if (size > 1 && coefficients_.back() == 1 &&
+                coefficients_[size - 2] < std::numeric_limits<long long>::max()) {
+                coefficients_.pop_back();
+                ++coefficients_.back();
+            }
+        } else {
+            const size_t period = size - period_start_;
+            for (size_t d = 1; d < period; ++d) {
+                if (period % d != 0) {
+                    continue;
+                }
+                const bool repeats = std::equal(coefficients_.begin() + static_cast<std::ptrdiff_t>(period_start_ + d),
+                                                coefficients_.end(),
+                                                coefficients_.begin() + static_cast<std::ptrdiff_t>(period_start_));
+                if (repeats) {
+                    coefficients_.resize(period_start_ + d);
+                    break;
+                }
+            }
+
+            while (period_start_ > 0 && coefficients_[period_start_ - 1] == coefficients_.back()) {
+                coefficients_.pop_back();
+                --period_start_;
+            }
+        }
+
+        invalidate_cache();
+    }
+
+    /**
+     * @brief Копия в каноническом виде
+     */
+    ContinuedFraction ContinuedFraction::canonical() const {
+        ContinuedFraction result(*this);
+        result.canonicalize();
+        return result;
+    }
+
+    namespace {
+        /**
+         * @brief Шаг хеширования: перемешивание коэффициента (splitmix64) и FNV-подобное накопление
+         */
+        std::uint64_t hash_step(std::uint64_t state, long long coeff) {
+            std::uint64_t x = static_cast<std::uint64_t>(coeff) + 0x9E3779B97F4A7C15ULL;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            x ^= x >> 31;
+            return (state ^ x) * 0x100000001B3ULL;
+        }
+    }
+
+    /**
+     * @brief Хеш канонического вида
+     *
+     * Для конечной дроби состояние хеша хранится для префикса без двух
+     * последних коэффициентов: их может изменить свертка при добавлении
+     * и правило [..., a, 1] → [..., a + 1]. Поэтому после add_coefficient()
+     * и append_range() дохешируются только новые коэффициенты.
+     * Периодическая дробь хешируется целиком по канонической копии.
+     */
+    std::uint64_t ContinuedFraction::hash() const {
+        if (hash_cached_) {
+            return cached_hash_;
+        }
+
+        std::uint64_t result;
+        if (period_start_ != npos) {
+            const ContinuedFraction c = canonical();
+            result = HASH_SEED;
+            for (long long coeff : c.coefficients_) {
+                result = hash_step(result, coeff);
+            }
+            result = hash_step(result, static_cast<long long>(c.period_start_));
+            result = hash_step(result, static_cast<long long>(c.coefficients_.size() - c.period_start_));
+        } else {
+            const size_t size = coefficients_.size();
+            const size_t stable = size >= 2 ? size - 2 : 0;
+            if (hashed_terms_ > stable) {
+                // Дробь укоротилась сверткой: префикс хешируется заново
+                hash_state_ = HASH_SEED;
+                hashed_terms_ = 0;
+            }
+            for (; hashed_terms_ < stable; ++hashed_terms_) {
+                hash_state_ = hash_step(hash_state_, coefficients_[hashed_terms_]);
+            }
+
+            result = hash_state_;
+            size_t length = size;
+            if (size >= 2 && coefficients_.back() == 1 &&
+                coefficients_[size - 2] < std::numeric_limits<long long>::max()) {
+                result = hash_step(result, coefficients_[size - 2] + 1);
+                length = size - 1;
+            } else {
+                for (size_t i = stable; i < size; ++i) {
+                    result = hash_step(result, coefficients_[i]);
+                }
+            }
+            result = hash_step(result, -static_cast<long long>(length));
+        }
+
+        cached_hash_ = result;
+        hash_cached_ = true;
+        return result;
+    }
+
+    /**
+     * @brief Заполнение кэшей перед передачей объекта нескольким потокам
+     *
+     * Кэш подходящих дробей доходит до конца конечной дроби, первой
+     * переполненной дроби или MAX_CHECKED_DEPTH, после чего
+     * extend_convergents() ничего не записывает.
+     */
+    void ContinuedFraction::warm_caches() const {
+        to_double();
+        hash();
+        extend_convergents(period_start_ == npos ? coefficients_.size() - 1 : MAX_CHECKED_DEPTH - 1);
     }
 
     // ==================== РЕАЛИЗАЦИЯ АРИФМЕТИЧЕСКИХ ОПЕРАТОРОВ ====================
 
+    namespace {
+        /**
+         * @brief Привести операнд к регулярному виду (aᵢ ≥ 1 при i ≥ 1)
+         *
+         * Алгоритм Госпера рассчитан на регулярные дроби. Конечная
+         * нерегулярная дробь сворачивается в точное рациональное число
+         * и раскладывается заново; периодическая используется как есть.
+         */
+        ContinuedFraction regular_operand(const ContinuedFraction& cf) {
+            if (!cf.is_finite()) {
+                return cf;
+            }
+
+            const std::span<const long long> coeffs = cf.coefficients();
+            bool regular = std::all_of(coeffs.begin() + 1, coeffs.end(),
+                                       [](long long c) { return c >= 1; });
+            if (regular) {
+                return cf;
+            }
+
+            // Вычисление значения с конца: p/q = aᵢ + 1/(p/q)
+            long long p = coeffs.back();
+            long long q = 1;
+            for (auto it = coeffs.rbegin() + 1; it != coeffs.rend(); ++it) {
+                long long next_p = detail::mul_add_or_throw(*it, p, q);
+                q = p;
+                p = next_p;
+            }
+            return ContinuedFraction::from_rational(p, q);
+        }
+
+        /**
+         * @brief Количество коэффициентов результата операции
+         */
+        size_t result_terms(const ContinuedFraction& a, const ContinuedFraction& b) {
+            if (a.is_finite() && b.is_finite()) {
+                return std::numeric_limits<size_t>::max();
+            }
+            return ContinuedFraction::INFINITE_ARITHMETIC_TERMS;
+        }
+    }
+
     /**
      * @brief Сложение цепных дробей
      *
-     * Внимание: текущая реализация через преобразование к double.
-     * Для точной арифметики требуются специальные алгоритмы.
+     * Точное вычисление потоковым алгоритмом Госпера
      */
     ContinuedFraction ContinuedFraction::operator+(const ContinuedFraction& other) const {
-        double result = this->to_double() + other.to_double();
-        return ContinuedFraction::from_double(result);
+        return BihomographicStream::sum(make_term_source(regular_operand(*this)),
+                                        make_term_source(regular_operand(other)))
+            .take(result_terms(*this, other));
     }
 
     /**
      * @brief Вычитание цепных дробей
      */
     ContinuedFraction ContinuedFraction::operator-(const ContinuedFraction& other) const {
-        double result = this->to_double() - other.to_double();
-        return ContinuedFraction::from_double(result);
+        return BihomographicStream::difference(make_term_source(regular_operand(*this)),
+                                               make_term_source(regular_operand(other)))
+            .take(result_terms(*this, other));
     }
 
     /**
      * @brief Умножение цепных дробей
      */
     ContinuedFraction ContinuedFraction::operator*(const ContinuedFraction& other) const {
-        double result = this->to_double() * other.to_double();
-        return ContinuedFraction::from_double(result);
+        return BihomographicStream::product(make_term_source(regular_operand(*this)),
+                                            make_term_source(regular_operand(other)))
+            .take(result_terms(*this, other));
     }
 
     /**
@@ -297,11 +1010,14 @@ namespace Math {
      * @throw std::runtime_error при делении на ноль
      */
     ContinuedFraction ContinuedFraction::operator/(const ContinuedFraction& other) const {
-        if (std::abs(other.to_double()) < 1e-15) {
+        // Нерегулярная запись нуля (например, [1; -1]) проверяется после свертки
+        const ContinuedFraction divisor = regular_operand(other);
+        if (divisor.coefficients_.size() == 1 && divisor.coefficients_[0] == 0) {
             throw std::runtime_error("Деление на ноль");
         }
-        double result = this->to_double() / other.to_double();
-        return ContinuedFraction::from_double(result);
+        return BihomographicStream::quotient(make_term_source(regular_operand(*this)),
+                                             make_term_source(divisor))
+            .take(result_terms(*this, other));
     }
 
     /**
@@ -341,20 +1057,14 @@ namespace Math {
     /**
      * @brief Проверка точного равенства
      *
-     * Сравнивает коэффициенты и их метаданные
+     * Сравнивает коэффициенты и начало периода
      */
     bool ContinuedFraction::operator==(const ContinuedFraction& other) const {
-        if (coefficients_.size() != other.coefficients_.size()) {
+        // Разные хеши - разные канонические виды, а значит, и представления
+        if (hash_cached_ && other.hash_cached_ && cached_hash_ != other.cached_hash_) {
             return false;
         }
-
-        for (size_t i = 0; i < coefficients_.size(); ++i) {
-            if (!(coefficients_[i] == other.coefficients_[i])) {
-                return false;
-            }
-        }
-
-        return true;
+        return view() == other.view();
     }
 
     /**
@@ -365,33 +1075,40 @@ namespace Math {
     }
 
     /**
-     * @brief Оператор "меньше"
+     * @brief Трехстороннее сравнение значений
      *
-     * Сравнивает численные значения
+     * Сравниваются коэффициенты (см. ContinuedFractionView), без to_double()
+     */
+    std::weak_ordering ContinuedFraction::operator<=>(const ContinuedFraction& other) const {
+        return view() <=> other.view();
+    }
+
+    /**
+     * @brief Оператор "меньше"
      */
     bool ContinuedFraction::operator<(const ContinuedFraction& other) const {
-        return this->to_double() < other.to_double();
+        return (*this <=> other) < 0;
     }
 
     /**
      * @brief Оператор "меньше или равно"
      */
     bool ContinuedFraction::operator<=(const ContinuedFraction& other) const {
-        return this->to_double() <= other.to_double();
+        return (*this <=> other) <= 0;
     }
 
     /**
      * @brief Оператор "больше"
      */
     bool ContinuedFraction::operator>(const ContinuedFraction& other) const {
-        return this->to_double() > other.to_double();
+        return (*this <=> other) > 0;
     }
 
     /**
      * @brief Оператор "больше или равно"
      */
     bool ContinuedFraction::operator>=(const ContinuedFraction& other) const {
-        return this->to_double() >= other.to_double();
+        return (*this <=> other) >= 0;
     }
 
     // ==================== РЕАЛИЗАЦИЯ ВВОДА/ВЫВОДА ====================
@@ -404,258 +1121,335 @@ namespace Math {
      * Формат: [a0; (a1, a2, ...)] для периодических
      */
     std::string ContinuedFraction::to_string() const {
-        if (coefficients_.empty()) {
-            return "[0]";
-        }
-
-        std::ostringstream oss;
-        oss << "[" << coefficients_[0].signed_value();
-
-        for (size_t i = 1; i < coefficients_.size(); ++i) {
-            if (coefficients_[i].is_periodic_marker) {
-                oss << "; (";
-            } else {
-                oss << "; ";
-            }
-            oss << coefficients_[i].signed_value();
-        }
-
-        if (is_periodic_) {
-            oss << ")]";
-        } else {
-            oss << "]";
-        }
+        return view().to_string();
+    }
 
-        return oss.str();
+    /**
+     * @brief Длина строкового представления
+     */
+    size_t ContinuedFraction::formatted_size() const {
+        return view().formatted_size();
     }
 
     /**
-     * @brief Парсинг строки
-     * @param str Строка для парсинга
-     * @throw std::invalid_argument при ошибке
-     *
-     * Поддерживает форматы:
-     * - [a0; a1, a2, ...]
-     * - [a0; (a1, a2, ...)]
+     * @brief Запись строкового представления в буфер
      */
-    void ContinuedFraction::parse_string(const std::string& str) {
-        coefficients_.clear();
+    char* ContinuedFraction::format_to(char* out) const {
+        return view().format_to(out);
+    }
 
-        // Регулярное выражение для проверки формата
-        std::regex pattern(R"(^\[([^\[\]]+)\]$)");
-        std::smatch match;
+    // ==================== РЕАЛИЗАЦИЯ СТАТИЧЕСКИХ МЕТОДОВ ====================
 
-        if (!std::regex_match(str, match, pattern)) {
-            throw std::invalid_argument("Неверный формат цепной дроби");
+    namespace {
+        /**
+         * @brief Алгоритм Евклида с округлением частных вниз в BigInt
+         * @param max_terms Наибольшее количество коэффициентов
+         * @param alloc Распределитель буфера коэффициентов
+         * @throw std::overflow_error Если коэффициент не помещается в long long
+         */
+        ContinuedFraction::Coefficients euclid_terms(BigInt n, BigInt d, size_t max_terms,
+                                                     const ContinuedFraction::allocator_type& alloc) {
+            ContinuedFraction::Coefficients coeffs(alloc);
+            BigInt q;
+            BigInt r;
+
+            while (!d.is_zero() && coeffs.size() < max_terms) {
+                BigInt::floor_divmod(n, d, q, r);
+                std::optional<long long> term = q.to_int64();
+                if (!term) {
+                    throw std::overflow_error("Коэффициент цепной дроби не помещается в long long");
+                }
+                coeffs.push_back(*term);
+                n = std::move(d);
+                d = std::move(r);
+            }
+            return coeffs;
         }
 
-        std::string content = match[1];
-        std::istringstream iss(content);
-        char ch;
-
-        // Чтение первого коэффициента
-        long long coeff;
-        if (!(iss >> coeff)) {
-            throw std::invalid_argument("Ошибка чтения первого коэффициента");
-        }
-        coefficients_.emplace_back(coeff);
+        /**
+         * @brief Точное значение конечного double в виде numerator / denominator
+         *
+         * value = m·2ᵉ, |m| < 2⁵³; дробь сокращается на степень двойки,
+         * чтобы знаменатель обычных значений помещался в long long.
+         */
+        void binary_fraction(double value, BigInt& numerator, BigInt& denominator) {
+            int exponent = 0;
+            const double fraction = std::frexp(value, &exponent);
+            long long mantissa = static_cast<long long>(
+                std::ldexp(fraction, std::numeric_limits<double>::digits));
+            exponent -= std::numeric_limits<double>::digits;
+
+            while (mantissa != 0 && mantissa % 2 == 0 && exponent < 0) {
+                mantissa /= 2;
+                ++exponent;
+            }
 
-        // Чтение остальных коэффициентов
-        while (iss >> ch && ch == ';') {
-            iss >> coeff;
-            coefficients_.emplace_back(coeff);
+            if (exponent >= 0) {
+                numerator = BigInt(mantissa) * BigInt::power_of_two(static_cast<size_t>(exponent));
+                denominator = 1;
+            } else {
+                numerator = mantissa;
+                denominator = BigInt::power_of_two(static_cast<size_t>(-exponent));
+            }
         }
-
-        normalize();
-    }
-
-    /**
-     * @brief Оператор вывода
-     */
-    std::ostream& operator<<(std::ostream& os, const ContinuedFraction& cf) {
-        os << cf.to_string();
-        return os;
-    }
-
-    /**
-     * @brief Оператор ввода
-     */
-    std::istream& operator>>(std::istream& is, ContinuedFraction& cf) {
-        std::string str;
-        std::getline(is, str);
-        cf.parse_string(str);
-        return is;
     }
 
-    // ==================== РЕАЛИЗАЦИЯ СТАТИЧЕСКИХ МЕТОДОВ ====================
-
     /**
      * @brief Создание из десятичного числа
      * @param value Десятичное число
      * @param max_terms Максимальное число коэффициентов
+     * @param alloc Распределитель памяти
      * @return Цепная дробь
      *
-     * Алгоритм: повторное выделение целой части
+     * Конечное значение double - двоичная дробь m·2ᵉ, |m| < 2⁵³.
+     * Она раскладывается алгоритмом Евклида в целых числах, поэтому
+     * коэффициенты точны, а разложение всегда конечно.
      */
-    ContinuedFraction ContinuedFraction::from_double(double value, size_t max_terms) {
-        std::vector<long long> coeffs;
-
-        for (size_t i = 0; i < max_terms; ++i) {
-            long long integer_part = static_cast<long long>(std::floor(value));
-            coeffs.push_back(integer_part);
-
-            double fractional = value - integer_part;
-            if (std::abs(fractional) < 1e-12) {
-                break;
-            }
-
-            value = 1.0 / fractional;
+    ContinuedFraction ContinuedFraction::from_double(double value, size_t max_terms,
+                                                     const allocator_type& alloc) {
+        if (!std::isfinite(value)) {
+            throw std::invalid_argument("Разложить можно только конечное значение double");
         }
 
-        return ContinuedFraction(coeffs);
+        BigInt numerator;
+        BigInt denominator;
+        binary_fraction(value, numerator, denominator);
+        return ContinuedFraction(euclid_terms(std::move(numerator), std::move(denominator),
+                                              max_terms, alloc), npos);
     }
 
     /**
      * @brief Создание из рационального числа
      * @param numerator Числитель
      * @param denominator Знаменатель
+     * @param alloc Распределитель памяти
      * @return Цепная дробь
      * @throw std::invalid_argument при нулевом знаменателе
      *
-     * Использует алгоритм Евклида
+     * Использует алгоритм Евклида с округлением частных вниз,
+     * поэтому результат всегда регулярный: [a0; a1, ...], aᵢ ≥ 1 при i ≥ 1
      */
     ContinuedFraction ContinuedFraction::from_rational(long long numerator,
-                                                      long long denominator) {
+                                                      long long denominator,
+                                                      const allocator_type& alloc) {
         if (denominator == 0) {
             throw std::invalid_argument("Знаменатель не может быть нулевым");
         }
 
-        std::vector<long long> coeffs;
+        Coefficients coeffs(alloc);
         long long n = numerator;
         long long d = denominator;
 
         // Алгоритм Евклида для цепных дробей
         while (d != 0) {
-            long long q = n / d;
-            long long r = n % d;
+            long long q = detail::floor_div(n, d);
+            long long r = n - q * d;
             coeffs.push_back(q);
             n = d;
             d = r;
         }
 
-        return ContinuedFraction(coeffs);
+        return ContinuedFraction(std::move(coeffs), npos);
+    }
+
+    /**
+     * @brief Создание из рационального числа произвольной точности
+     * @param numerator Числитель
+     * @param denominator Знаменатель
+     * @param alloc Распределитель памяти
+     * @return Цепная дробь
+     * @throw std::invalid_argument при нулевом знаменателе
+     * @throw std::overflow_error если коэффициент не помещается в long long
+     *
+     * Алгоритм Евклида с округлением частных вниз в BigInt
+     */
+    ContinuedFraction ContinuedFraction::from_rational(const BigInt& numerator,
+                                                      const BigInt& denominator,
+                                                      const allocator_type& alloc) {
+        if (denominator.is_zero()) {
+            throw std::invalid_argument("Знаменатель не может быть нулевым");
+        }
+        return ContinuedFraction(euclid_terms(numerator, denominator, npos, alloc), npos);
+    }
+
+    /**
+     * @brief Дробь из готового буфера
+     * @param coeffs Буфер коэффициентов (перемещается)
+     * @param period_start Начало периода
+     */
+    ContinuedFraction ContinuedFraction::from_coefficients(Coefficients&& coeffs, size_t period_start) {
+        return ContinuedFraction(std::move(coeffs), period_start);
     }
 
     /**
      * @brief Создание периодической дроби
      * @param non_periodic Непериодическая часть
      * @param periodic Периодическая часть
+     * @param alloc Распределитель памяти
      * @return Периодическая цепная дробь
      */
     ContinuedFraction ContinuedFraction::create_periodic(
         const std::vector<long long>& non_periodic,
-        const std::vector<long long>& periodic) {
+        const std::vector<long long>& periodic,
+        const allocator_type& alloc) {
 
-        std::vector<Coefficient> coeffs;
+        ContinuedFraction cf(alloc);
+        cf.coefficients_.clear();
+        cf.coefficients_.reserve(non_periodic.size() + periodic.size());
+        cf.coefficients_.insert(cf.coefficients_.end(), non_periodic.begin(), non_periodic.end());
 
-        // Непериодическая часть
-        for (long long c : non_periodic) {
-            coeffs.emplace_back(c);
-        }
-
-        // Периодическая часть с маркером
+        // Периодическая часть начинается сразу после непериодической
         if (!periodic.empty()) {
-            coeffs.emplace_back(periodic[0], false, true);
-            for (size_t i = 1; i < periodic.size(); ++i) {
-                coeffs.emplace_back(periodic[i]);
-            }
+            cf.period_start_ = non_periodic.size();
+            cf.coefficients_.insert(cf.coefficients_.end(), periodic.begin(), periodic.end());
         }
 
-        ContinuedFraction cf;
-        cf.coefficients_ = coeffs;
         cf.normalize();
         return cf;
     }
 
     // ==================== РЕАЛИЗАЦИЯ СВОЙСТВ ====================
 
-    /**
-     * @brief Проверка конечности
-     */
-    bool ContinuedFraction::is_finite() const { return is_finite_; }
-
-    /**
-     * @brief Проверка периодичности
-     */
-    bool ContinuedFraction::is_periodic() const { return is_periodic_; }
-
-    /**
-     * @brief Количество коэффициентов
-     */
-    size_t ContinuedFraction::size() const { return coefficients_.size(); }
-
-    /**
-     * @brief Проверка целочисленности
-     */
-    bool ContinuedFraction::is_integer() const {
-        return coefficients_.size() == 1;
-    }
-
     /**
      * @brief Очистка дроби
      */
     void ContinuedFraction::clear() {
-        coefficients_.clear();
-        coefficients_.emplace_back(0);
+        coefficients_.assign(1, 0);
+        period_start_ = npos;
         normalize();
     }
 
     // ==================== РЕАЛИЗАЦИЯ ВНЕШНИХ ФУНКЦИЙ ====================
 
+    namespace {
+        /**
+         * @class SqrtCache
+         * @brief Кэш полных разложений √n
+         *
+         * Хранит не более MAX_TERMS коэффициентов суммарно; при
+         * переполнении очищается целиком.
+         */
+        class SqrtCache {
+        public:
+            static constexpr size_t MAX_TERMS = 1 << 20;
+
+            std::shared_ptr<const ContinuedFraction> find(long long n) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                auto it = entries_.find(n);
+                return it != entries_.end() ? it->second : nullptr;
+            }
+
+            void insert(long long n, std::shared_ptr<const ContinuedFraction> cf) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (cf->size() > MAX_TERMS) {
+                    return;
+                }
+                if (terms_ + cf->size() > MAX_TERMS) {
+                    entries_.clear();
+                    terms_ = 0;
+                }
+                if (entries_.emplace(n, cf).second) {
+                    terms_ += cf->size();
+                }
+            }
+
+        private:
+            std::mutex mutex_;
+            std::unordered_map<long long, std::shared_ptr<const ContinuedFraction>> entries_;
+            size_t terms_ = 0;   ///< Суммарное количество коэффициентов
+        };
+
+        SqrtCache& sqrt_cache() {
+            static SqrtCache cache;
+            return cache;
+        }
+
+        /**
+         * @brief Построить разложение √n, не более max_terms коэффициентов периода
+         * @param complete true, если период поместился целиком
+         */
+        ContinuedFraction build_sqrt_expansion(long long n, size_t max_terms, bool& complete) {
+            detail::SqrtTermGenerator terms(n);
+            complete = true;
+            if (terms.is_perfect_square()) {
+                return ContinuedFraction(terms.a0());
+            }
+
+            ContinuedFraction::Builder builder;
+            builder.push_back(terms.a0()).begin_period();
+            while (true) {
+                if (builder.size() - 1 >= max_terms) {
+                    complete = false;
+                    builder.cancel_period();
+                    break;
+                }
+                const long long a = terms.next();
+                builder.push_back(a);
+                if (terms.closes_period(a)) {
+                    break;
+                }
+            }
+            return builder.finish();
+        }
+    }
+
     /**
      * @brief Цепная дробь для квадратного корня
-     * @param n Число под корнем
-     * @param max_terms Максимальное число коэффициентов
+     * @param n Число
+     * @param max_terms Предельная длина периода
+     * @param truncated Признак усечения периода
      * @return Цепная дробь √n
-     * @throw std::invalid_argument при отрицательном n
      *
-     * Алгоритм: метод последовательных приближений
-     * Для √n цепная дробь всегда периодическая
+     * Алгоритм: m₀ = 0, d₀ = 1, a₀ = ⌊√n⌋
+     * mᵢ₊₁ = dᵢaᵢ - mᵢ
+     * dᵢ₊₁ = (n - mᵢ₊₁²)/dᵢ
+     * aᵢ₊₁ = ⌊(a₀ + mᵢ₊₁)/dᵢ₊₁⌋
      */
-    ContinuedFraction sqrt_continued_fraction(long long n, size_t max_terms) {
+    ContinuedFraction sqrt_continued_fraction(long long n, size_t max_terms, bool* truncated) {
         if (n < 0) {
             throw std::invalid_argument("Нельзя вычислить корень из отрицательного числа");
         }
 
-        std::vector<long long> coeffs;
-        long long m = 0;
-        long long d = 1;
-        long long a0 = static_cast<long long>(std::sqrt(n));
-
-        // Если n - полный квадрат
-        if (a0 * a0 == n) {
-            return ContinuedFraction(a0);
+        if (std::shared_ptr<const ContinuedFraction> cached = sqrt_cache().find(n)) {
+            if (cached->size() - 1 <= max_terms) {
+                if (truncated != nullptr) {
+                    *truncated = false;
+                }
+                return *cached;
+            }
         }
 
-        coeffs.push_back(a0);
-        long long a = a0;
+        bool complete;
+        ContinuedFraction cf = build_sqrt_expansion(n, max_terms, complete);
+        if (truncated != nullptr) {
+            *truncated = !complete;
+        }
+        if (complete) {
+            auto shared = std::make_shared<const ContinuedFraction>(cf);
+            shared->warm_caches();
+            sqrt_cache().insert(n, std::move(shared));
+        }
+        return cf;
+    }
 
-        // Вычисление периода
-        for (size_t i = 0; i < max_terms; ++i) {
-            m = d * a - m;
-            d = (n - m * m) / d;
-            a = (a0 + m) / d;
-            coeffs.push_back(a);
+    /**
+     * @brief Разложение √n из кэша
+     */
+    std::shared_ptr<const ContinuedFraction> cached_sqrt_continued_fraction(long long n) {
+        if (n < 0) {
+            throw std::invalid_argument("Нельзя вычислить корень из отрицательного числа");
+        }
 
-            // Критерий завершения периода
-            if (a == 2 * a0) {
-                break;
-            }
+        if (std::shared_ptr<const ContinuedFraction> cached = sqrt_cache().find(n)) {
+            return cached;
         }
 
-        // Создание периодической дроби
-        return ContinuedFraction::create_periodic({a0},
-            std::vector<long long>(coeffs.begin() + 1, coeffs.end()));
+        bool complete;
+        auto cf = std::make_shared<const ContinuedFraction>(
+            build_sqrt_expansion(n, ContinuedFraction::npos, complete));
+        cf->warm_caches();
+        sqrt_cache().insert(n, cf);
+        return cf;
     }
 
     /**
@@ -666,31 +1460,69 @@ namespace Math {
      * Известное разложение: e = [2; 1, 2, 1, 1, 4, 1, 1, 6, 1, ...]
      */
     ContinuedFraction e_continued_fraction(size_t max_terms) {
-        std::vector<long long> coeffs;
-        coeffs.push_back(2);  // Первый коэффициент
-
+        ContinuedFraction::Builder builder(max_terms);
+        builder.push_back(detail::e_term(0));
         for (size_t i = 1; i < max_terms; ++i) {
-            if (i % 3 == 2) {
-                // Каждый третий коэффициент, начиная со второго
-                coeffs.push_back(2 * ((i + 1) / 3));
-            } else {
-                // Остальные коэффициенты равны 1
-                coeffs.push_back(1);
-            }
+            builder.push_back(detail::e_term(i));
         }
-
-        return ContinuedFraction(coeffs);
+        return builder.finish();
     }
 
     /**
      * @brief Цепная дробь для числа π
-     * @param max_terms Максимальное число коэффициентов
-     * @return Приближение π
+     * @param max_terms Количество коэффициентов
+     * @return Точные первые коэффициенты π
      *
-     * Внимание: это простая цепная дробь, не оптимальное приближение
-     * Для лучших приближений нужны специальные алгоритмы
+     * Коэффициенты получаются из интервала, гарантированно содержащего π
+     * (см. detail::pi_terms), а не из приближения double.
      */
     ContinuedFraction pi_continued_fraction(size_t max_terms) {
-        return ContinuedFraction::from_double(3.14159265358979323846, max_terms);
+        return ContinuedFraction(detail::pi_terms(max_terms));
+    }
+
+    /**
+     * @brief Наилучшее приближение по точному разложению double
+     */
+    std::pair<long long, long long> best_rational(double value, long long max_denominator) {
+        if (max_denominator < 1) {
+            throw std::invalid_argument("Наибольший знаменатель должен быть положительным");
+        }
+        if (!std::isfinite(value)) {
+            throw std::invalid_argument("Приближение определено только для конечного значения double");
+        }
+
+        BigInt n;
+        BigInt d;
+        binary_fraction(value, n, d);
+
+        // Коэффициент больше 2·max_denominator + 1 всегда завершает перебор
+        // и не проходит правило половины, поэтому его можно заменить этой
+        // границей и остановиться: так крошечные дроби вида [0; 2¹⁰⁷⁴]
+        // не приводят к переполнению long long
+        const long long cap = max_denominator < std::numeric_limits<long long>::max() / 2
+            ? 2 * max_denominator + 2
+            : std::numeric_limits<long long>::max();
+
+        std::vector<long long> coeffs;
+        BigInt q;
+        BigInt r;
+        while (!d.is_zero()) {
+            BigInt::floor_divmod(n, d, q, r);
+            const std::optional<long long> term = q.to_int64();
+            if (coeffs.empty()) {
+                if (!term) {
+                    throw std::overflow_error("Числитель наилучшего приближения не помещается в long long");
+                }
+                coeffs.push_back(*term);
+            } else if (!term || *term >= cap) {
+                coeffs.push_back(cap);
+                break;
+            } else {
+                coeffs.push_back(*term);
+            }
+            n = std::move(d);
+            d = std::move(r);
+        }
+        return ContinuedFraction(std::move(coeffs)).best_rational(max_denominator);
     }
-}
\ No newline at end of file
+}
@@ -11,98 +11,210 @@
  * a₀ + 1/(a₁ + 1/(a₂ + 1/(a₃ + ...)))
  * где aᵢ - целые коэффициенты.
  *
+ * Заголовок содержит только ядро библиотеки и не подключает потоки
+ * ввода/вывода; операторы << и >> и поддержка std::format объявлены
+ * в continued_fraction_io.h.
+ *
  * Лицензия: MIT
  */
 
 #ifndef CONTINUED_FRACTION_H
 #define CONTINUED_FRACTION_H
 
+#include "big_integer.h"
+#include "continued_fraction_view.h"
+#include "small_vector.h"
 #include <vector>
 #include <string>
-#include <iostream>
-#include <sstream>
-#include <algorithm>
-#include <numeric>
 #include <cmath>
+#include <cstddef>
 #include <stdexcept>
-#include <type_traits>
 #include <memory>
-#include <limits>
-#include <regex>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <compare>
+#include <cstdint>
 
 namespace Math {
+    /**
+     * @class ParseError
+     * @brief Ошибка разбора строкового представления цепной дроби
+     *
+     * Помимо сообщения содержит позицию (смещение в строке),
+     * на которой обнаружена ошибка.
+     */
+    class ParseError : public std::invalid_argument {
+    public:
+        /**
+         * @brief Конструктор
+         * @param message Описание ошибки
+         * @param position Смещение ошибочного символа от начала строки
+         */
+        ParseError(const std::string& message, size_t position)
+            : std::invalid_argument(message + " (позиция " + std::to_string(position) + ")")
+            , position_(position) {}
+
+        /**
+         * @brief Позиция ошибки в строке
+         */
+        size_t position() const noexcept { return position_; }
+
+    private:
+        size_t position_;   ///< Смещение ошибочного символа
+    };
+
     /**
      * @class ContinuedFraction
      * @brief Класс для представления цепных дробей
      *
      * Поддерживает конечные и периодические цепные дроби,
      * алгебраические операции, преобразования и вычисления.
+     *
+     * Класс поддерживает распределители std::pmr так же, как
+     * std::pmr-контейнеры: память под коэффициенты дробей длиннее
+     * INLINE_TERMS и под кэш подходящих дробей берется из ресурса,
+     * переданного в конструктор (по умолчанию - get_default_resource()).
+     * Копия получает ресурс по умолчанию, присваивание сохраняет ресурс
+     * приемника, а std::pmr::vector<ContinuedFraction> передает свой
+     * ресурс элементам сам. Поэтому множество временных дробей можно
+     * разместить в std::pmr::monotonic_buffer_resource и освободить разом.
      */
     class ContinuedFraction {
-    private:
+    public:
         /**
-         * @struct Coefficient
-         * @brief Внутренняя структура для хранения коэффициентов с метаданными
+         * @brief Значение "нет индекса" (например, у непериодической дроби)
          */
-        struct Coefficient {
-            long long value;           ///< Абсолютное значение коэффициента
-            bool is_negative;          ///< Флаг отрицательности
-            bool is_periodic_marker;   ///< Флаг начала периодической части
+        static constexpr size_t npos = static_cast<size_t>(-1);
 
-            /**
-             * @brief Конструктор коэффициента
-             * @param val Значение коэффициента
-             * @param neg Флаг отрицательности
-             * @param periodic Флаг начала периода
-             */
-            explicit Coefficient(long long val = 0,
-                               bool neg = false,
-                               bool periodic = false)
-                : value(std::abs(val))
-                , is_negative(val < 0 || neg)
-                , is_periodic_marker(periodic) {}
+        /**
+         * @brief Количество коэффициентов результата арифметической операции,
+         *        если хотя бы один операнд бесконечен
+         */
+        static constexpr size_t INFINITE_ARITHMETIC_TERMS = 20;
 
-            /**
-             * @brief Получить знаковое значение коэффициента
-             * @return Значение с учетом знака
-             */
-            long long signed_value() const {
-                return is_negative ? -value : value;
-            }
+        /**
+         * @brief Индекс, начиная с которого exact_convergent() перемножает
+         *        матрицы коэффициентов деревом вместо рекуррентной формулы
+         */
+        static constexpr size_t TREE_CONVERGENT_THRESHOLD = 256;
 
-            /**
-             * @brief Оператор сравнения коэффициентов
-             */
-            bool operator==(const Coefficient& other) const {
-                return signed_value() == other.signed_value() &&
-                       is_periodic_marker == other.is_periodic_marker;
-            }
-        };
+        /**
+         * @brief Количество коэффициентов, хранимых внутри объекта
+         *
+         * Дроби не длиннее INLINE_TERMS создаются, копируются и
+         * уничтожаются без выделения памяти.
+         */
+        static constexpr size_t INLINE_TERMS = 8;
 
+        /**
+         * @brief Буфер коэффициентов со встроенным хранилищем
+         */
+        using Coefficients = SmallVector<long long, INLINE_TERMS>;
+
+        /**
+         * @brief Тип распределителя (см. std::uses_allocator)
+         */
+        using allocator_type = std::pmr::polymorphic_allocator<long long>;
+
+    private:
         // Приватные поля класса
-        std::vector<Coefficient> coefficients_;  ///< Вектор коэффициентов цепной дроби
-        bool is_finite_;                         ///< Флаг конечности дроби
-        bool is_periodic_;                       ///< Флаг периодичности
+        Coefficients coefficients_;              ///< Коэффициенты цепной дроби (со знаком)
+        size_t period_start_;                    ///< Индекс начала периода или npos (конечная дробь)
         mutable double cached_value_;            ///< Кэшированное числовое значение
         mutable bool value_cached_;              ///< Флаг валидности кэша
+        mutable std::pmr::vector<std::pair<long long, long long>> convergents_; ///< Кэш подходящих дробей {pₖ, qₖ}
+        mutable size_t convergent_overflow_;     ///< Индекс первой переполненной подходящей дроби или npos
+        mutable std::uint64_t hash_state_ = HASH_SEED;   ///< Состояние хеша префикса [0, hashed_terms_)
+        mutable size_t hashed_terms_ = 0;                ///< Длина захешированного префикса
+        mutable std::uint64_t cached_hash_ = 0;          ///< Кэшированный хеш канонического вида
+        mutable bool hash_cached_ = false;               ///< Флаг валидности cached_hash_
+
+        /**
+         * @struct ForwardState
+         * @brief Состояние прямого вычисления значения конечной дроби
+         *
+         * [[p, p_prev], [q, q_prev]] - подходящие дроби после первых
+         * terms коэффициентов (в long double).
+         */
+        struct ForwardState {
+            long double p = 1, p_prev = 0;
+            long double q = 0, q_prev = 1;
+            size_t terms = 0;         ///< Обработано коэффициентов
+            bool converged = false;   ///< Дальнейшие коэффициенты не меняют double
+            bool regular = true;      ///< Все обработанные aᵢ ≥ 1 при i ≥ 1
+
+            /**
+             * @brief Учесть следующий коэффициент
+             */
+            void push(long long coeff);
+        };
+
+        mutable ForwardState forward_;   ///< Состояние вычисления to_double()
+        bool pending_zero_ = false;      ///< Отброшенный завершающий ноль, ждущий следующего коэффициента
+
+        /**
+         * @brief Начальное состояние хеша (смещение FNV-1a)
+         */
+        static constexpr std::uint64_t HASH_SEED = 0xCBF29CE484222325ULL;
 
         /**
          * @brief Нормализация коэффициентов цепной дроби
          *
-         * Удаляет лишние нули, выполняет оптимизацию вида [..., a, 1, b] → [..., a+1, b]
+         * Сворачивает нулевые коэффициенты вида [..., a, 0, b, ...] → [..., a+b, ...]
+         * и отбрасывает завершающий ноль. Выполняется за один проход, O(n).
+         *
+         * @throw std::overflow_error Если сумма a+b не помещается в long long
          */
         void normalize();
 
         /**
-         * @brief Обновление флагов конечности и периодичности
+         * @brief Нормализация, начиная с индекса first
+         *
+         * Префикс [0, first) считается уже нормализованным;
+         * обрабатываются только коэффициенты начиная с first.
+         *
+         * Отброшенный завершающий ноль запоминается в pending_zero_
+         * и сворачивается со следующим добавленным коэффициентом.
+         *
+         * @param first Индекс первого ненормализованного коэффициента (≥ 1)
+         * @return Наименьший индекс, коэффициент с которым мог измениться
+         * @throw std::overflow_error Если свертка нуля не помещается в long long
          */
-        void update_flags();
+        size_t normalize_from(size_t first);
+
+        /**
+         * @brief Конструктор из готового буфера и начала периода
+         * @param coeffs Коэффициенты (перемещаются)
+         * @param period_start Индекс начала периода или npos
+         */
+        ContinuedFraction(Coefficients&& coeffs, size_t period_start);
 
         /**
          * @brief Инвалидация кэшированного значения
          */
         void invalidate_cache() const;
 
+        /**
+         * @brief Коэффициент с индексом i для рекуррентных формул
+         * @param i Индекс коэффициента
+         */
+        long long coefficient_at(size_t i) const;
+
+        /**
+         * @brief Дополнить кэш подходящих дробей до индекса n включительно
+         * @param n Индекс подходящей дроби
+         */
+        void extend_convergents(size_t n) const;
+
+        /**
+         * @brief Продолжить подходящие дроби за концом кэша до индекса end
+         * @param func Вызывается как func(i, {pᵢ, qᵢ})
+         */
+        template <typename Func>
+        void wrapped_convergents(size_t end, Func&& func) const;
+
         /**
          * @brief Вычисление n-й подходящей дроби
          * @param n Индекс подходящей дроби
@@ -120,35 +232,67 @@ namespace Math {
          */
         ContinuedFraction();
 
+        /**
+         * @brief Дробь [0] с заданным распределителем
+         * @param alloc Распределитель памяти
+         */
+        explicit ContinuedFraction(const allocator_type& alloc);
+
         /**
          * @brief Конструктор из целого числа
          * @param value Целое число
+         * @param alloc Распределитель памяти
          */
-        explicit ContinuedFraction(long long value);
+        explicit ContinuedFraction(long long value, const allocator_type& alloc = {});
 
         /**
          * @brief Конструктор из вектора коэффициентов
          * @param coeffs Вектор целых коэффициентов
+         * @param alloc Распределитель памяти
          */
-        explicit ContinuedFraction(const std::vector<long long>& coeffs);
+        explicit ContinuedFraction(const std::vector<long long>& coeffs,
+                                   const allocator_type& alloc = {});
 
         /**
          * @brief Конструктор из строкового представления
          * @param str Строка в формате "[a0; a1, a2, ...]"
+         * @param alloc Распределитель памяти
          * @throw std::invalid_argument При неверном формате строки
          */
-        explicit ContinuedFraction(const std::string& str);
+        explicit ContinuedFraction(const std::string& str, const allocator_type& alloc = {});
+
+        /**
+         * @brief Конструктор из невладеющего представления
+         *
+         * Коэффициенты копируются и нормализуются.
+         *
+         * @param view Представление дроби
+         * @param alloc Распределитель памяти
+         */
+        explicit ContinuedFraction(ContinuedFractionView view, const allocator_type& alloc = {});
 
         /**
          * @brief Конструктор копирования
          */
         ContinuedFraction(const ContinuedFraction& other) = default;
 
+        /**
+         * @brief Копирование с заданным распределителем
+         */
+        ContinuedFraction(const ContinuedFraction& other, const allocator_type& alloc);
+
         /**
          * @brief Конструктор перемещения
          */
         ContinuedFraction(ContinuedFraction&& other) noexcept = default;
 
+        /**
+         * @brief Перемещение с заданным распределителем
+         *
+         * Если ресурсы различаются, буферы копируются.
+         */
+        ContinuedFraction(ContinuedFraction&& other, const allocator_type& alloc);
+
         /**
          * @brief Деструктор
          */
@@ -163,8 +307,16 @@ namespace Math {
 
         /**
          * @brief Оператор перемещающего присваивания
+         *
+         * Не noexcept: при разных ресурсах памяти буферы копируются
+         * в ресурс левой части, а выделение может бросить исключение.
          */
-        ContinuedFraction& operator=(ContinuedFraction&& other) noexcept = default;
+        ContinuedFraction& operator=(ContinuedFraction&& other) = default;
+
+        /**
+         * @brief Распределитель памяти дроби
+         */
+        allocator_type get_allocator() const noexcept { return coefficients_.get_allocator(); }
 
         // ==================== ОСНОВНЫЕ МЕТОДЫ ====================
 
@@ -174,6 +326,20 @@ namespace Math {
          */
         std::vector<long long> get_coefficients() const;
 
+        /**
+         * @brief Коэффициенты без копирования
+         * @return Представление, действительное до изменения дроби
+         */
+        std::span<const long long> coefficients() const noexcept { return coefficients_; }
+
+        /**
+         * @brief Невладеющее представление дроби
+         * @return Представление, действительное до изменения дроби
+         */
+        ContinuedFractionView view() const noexcept {
+            return ContinuedFractionView(coefficients_, period_start_);
+        }
+
         /**
          * @brief Установить новые коэффициенты
          * @param coeffs Вектор новых коэффициентов
@@ -182,10 +348,93 @@ namespace Math {
 
         /**
          * @brief Добавить коэффициент в конец цепной дроби
+         *
+         * Нормализуется только конец дроби, поэтому последовательное
+         * добавление коэффициентов стоит O(1) амортизированно.
+         * Ноль, добавленный в конечную дробь, не меняет ее значения, но
+         * сворачивается со следующим коэффициентом: [1; 2] после
+         * add_coefficient(0) и add_coefficient(3) равна [1; 5].
+         * У периодической дроби удлиняется период.
+         *
          * @param coeff Новый коэффициент
+         * @throw std::overflow_error Если свертка нуля не помещается в long long
          */
         void add_coefficient(long long coeff);
 
+        /**
+         * @brief Добавить несколько коэффициентов в конец цепной дроби
+         *
+         * Память резервируется один раз, нормализуется только
+         * добавленный участок.
+         *
+         * @param coeffs Добавляемые коэффициенты
+         */
+        void append_range(std::span<const long long> coeffs);
+
+        /**
+         * @class Builder
+         * @brief Построитель цепной дроби с отложенной нормализацией
+         *
+         * Коэффициенты накапливаются в буфере без нормализации;
+         * finish() перемещает буфер в цепную дробь и нормализует её
+         * один раз.
+         */
+        class Builder {
+        public:
+            /**
+             * @brief Конструктор по умолчанию
+             */
+            Builder() : period_start_(npos) {}
+
+            /**
+             * @brief Конструктор с резервированием памяти
+             * @param expected_terms Ожидаемое количество коэффициентов
+             */
+            explicit Builder(size_t expected_terms);
+
+            /**
+             * @brief Зарезервировать память под коэффициенты
+             */
+            Builder& reserve(size_t expected_terms);
+
+            /**
+             * @brief Добавить коэффициент
+             */
+            Builder& push_back(long long coeff);
+
+            /**
+             * @brief Добавить несколько коэффициентов
+             */
+            Builder& append(std::span<const long long> coeffs);
+
+            /**
+             * @brief Отметить, что следующие коэффициенты образуют период
+             */
+            Builder& begin_period();
+
+            /**
+             * @brief Снять отметку периода (дробь будет конечной)
+             */
+            Builder& cancel_period();
+
+            /**
+             * @brief Количество накопленных коэффициентов
+             */
+            size_t size() const { return coefficients_.size(); }
+
+            /**
+             * @brief Построить цепную дробь
+             *
+             * После вызова построитель пуст и может использоваться повторно.
+             * Пустой построитель дает дробь [0].
+             */
+            ContinuedFraction finish();
+
+        private:
+            Coefficients coefficients_;             ///< Накопленные коэффициенты
+            size_t period_start_;                   ///< Начало периода или npos
+        };
+
         /**
          * @brief Преобразовать цепную дробь в числовое значение
          * @return Приближенное значение типа double
@@ -200,14 +449,134 @@ namespace Math {
          */
         std::pair<long long, long long> convergent(size_t n) const;
 
+        /**
+         * @brief Получить подходящие дроби с индексами [begin, end)
+         *
+         * Подходящие дроби вычисляются один раз и хранятся в кэше объекта
+         * (до первой переполненной), а результат копируется, поэтому
+         * не зависит от последующих вызовов и изменений дроби.
+         *
+         * @param begin Индекс первой подходящей дроби
+         * @param end Индекс за последней подходящей дробью
+         * @return Пары {числитель, знаменатель}
+         * @throw std::out_of_range При выходе за границы
+         */
+        std::vector<std::pair<long long, long long>> convergents(size_t begin, size_t end) const;
+
+        /**
+         * @brief Получить n-ю подходящую дробь без переполнения
+         *
+         * Пока числитель и знаменатель помещаются в long long, вычисления
+         * не выделяют память; при росте значения переходят к BigInt.
+         * Для n ≥ TREE_CONVERGENT_THRESHOLD используется дерево
+         * произведений матриц; многопоточный вариант - tree_convergent()
+         * из matrix_product.h.
+         *
+         * @param n Индекс подходящей дроби (0-based)
+         * @return Пара {числитель, знаменатель} произвольной точности
+         * @throw std::out_of_range При выходе за границы
+         */
+        std::pair<BigInt, BigInt> exact_convergent(size_t n) const;
+
+        /**
+         * @brief Получить n-ю подходящую дробь с контролем переполнения
+         * @param n Индекс подходящей дроби (0-based)
+         * @return Пара {числитель, знаменатель}
+         * @throw std::out_of_range При выходе за границы
+         * @throw std::overflow_error Если pₙ или qₙ не помещается в long long
+         */
+        std::pair<long long, long long> checked_convergent(size_t n) const;
+
+        /**
+         * @brief Наилучшее рациональное приближение со знаменателем не больше max_denominator
+         *
+         * Среди всех p/q с 1 ≤ q ≤ max_denominator выбирается ближайшая
+         * к значению дроби (при равенстве расстояний - с меньшим знаменателем).
+         * Это последняя подходящая дробь pₖ/qₖ с qₖ ≤ max_denominator либо
+         * промежуточная дробь (t·pₖ + pₖ₋₁)/(t·qₖ + qₖ₋₁); выбор делается
+         * по коэффициентам в целых числах за O(k) шагов.
+         *
+         * @param max_denominator Наибольший допустимый знаменатель (≥ 1)
+         * @return Пара {числитель, знаменатель}
+         * @throw std::invalid_argument При max_denominator < 1 или нерегулярной дроби
+         *        (aᵢ ≤ 0 при i ≥ 1)
+         * @throw std::overflow_error Если числитель не помещается в long long
+         */
+        std::pair<long long, long long> best_rational(long long max_denominator) const;
+
+        /**
+         * @brief Количество начальных подходящих дробей, точно представимых в long long
+         *
+         * Для конечной дроби не превышает size(); для периодической
+         * просматривается не более MAX_CHECKED_DEPTH подходящих дробей.
+         *
+         * @return Индекс первой переполненной подходящей дроби
+         *         (или общее количество просмотренных, если переполнения нет)
+         */
+        size_t safe_convergent_depth() const;
+
+        /**
+         * @brief Предел просмотра в safe_convergent_depth() и длины кэша
+         *        подходящих дробей для периодических дробей
+         */
+        static constexpr size_t MAX_CHECKED_DEPTH = 4096;
+
         /**
          * @brief Упростить цепную дробь
          *
-         * Выполняет нормализацию и оптимизацию коэффициентов
+         * Приводит дробь к каноническому виду (см. canonicalize())
          */
         void simplify();
 
+        // ==================== КАНОНИЧЕСКИЙ ВИД И ХЕШ ====================
+
+        /**
+         * @brief Привести дробь к каноническому виду
+         *
+         * Нормализация не устраняет всей неоднозначности записи:
+         * [..., a, 1] = [..., a + 1], а у периодической дроби период
+         * можно повторить или "провернуть" в предпериод ([1; (1)] = [(1)]).
+         * Канонический вид: конечная дробь длиннее одного коэффициента
+         * не заканчивается единицей, период минимален, предпериод
+         * максимально короткий. Равные по значению регулярные дроби
+         * имеют одинаковый канонический вид.
+         */
+        void canonicalize();
+
+        /**
+         * @brief Копия в каноническом виде
+         */
+        ContinuedFraction canonical() const;
+
+        /**
+         * @brief 64-битный хеш канонического вида
+         *
+         * Кэшируется; у конечной дроби после add_coefficient() и
+         * append_range() пересчитываются только новые коэффициенты.
+         * Равные (operator==) дроби, как и дроби с одинаковым
+         * каноническим видом, имеют одинаковый хеш.
+         */
+        std::uint64_t hash() const;
+
+        /**
+         * @brief Заполнить кэши значения, хеша и подходящих дробей
+         *
+         * После вызова константные методы не изменяют объект, поэтому
+         * один экземпляр можно читать из нескольких потоков без
+         * синхронизации. Так подготавливаются общие экземпляры
+         * cached_sqrt_continued_fraction() и ContinuedFractionPool.
+         */
+        void warm_caches() const;
+
         // ==================== АРИФМЕТИЧЕСКИЕ ОПЕРАТОРЫ ====================
+        //
+        // Операции выполняются точно алгоритмом Госпера (см. homographic.h).
+        // Для конечных операндов результат - точная конечная дробь,
+        // иначе вычисляются первые INFINITE_ARITHMETIC_TERMS коэффициентов.
+        // Рациональный результат периодических операндов (например, √2·√2)
+        // завершается по правилу остановки BihomographicStream, которое
+        // является допущением. Коэффициент результата, не помещающийся
+        // в long long, приводит к std::overflow_error.
 
         /**
          * @brief Оператор сложения
@@ -255,7 +624,8 @@ namespace Math {
         /**
          * @brief Оператор равенства
          *
-         * Сравнивает точное представление цепных дробей
+         * Сравнивает точное представление цепных дробей; если хеши
+         * обеих дробей уже вычислены и различны, коэффициенты не сравниваются
          */
         bool operator==(const ContinuedFraction& other) const;
 
@@ -265,9 +635,18 @@ namespace Math {
         bool operator!=(const ContinuedFraction& other) const;
 
         /**
-         * @brief Оператор меньше
+         * @brief Трехстороннее сравнение числовых значений
          *
-         * Сравнивает числовые значения
+         * Сравнение идет по коэффициентам с чередованием знака и
+         * останавливается на первом различии, поэтому точно различает
+         * сколь угодно близкие дроби. Эквивалентность означает равенство
+         * значений, а не представлений (ср. operator==), поэтому порядок
+         * слабый.
+         */
+        std::weak_ordering operator<=>(const ContinuedFraction& other) const;
+
+        /**
+         * @brief Оператор меньше
          */
         bool operator<(const ContinuedFraction& other) const;
 
@@ -295,72 +674,147 @@ namespace Math {
         std::string to_string() const;
 
         /**
-         * @brief Парсинг строкового представления
-         * @param str Строка для парсинга
-         * @throw std::invalid_argument При неверном формате
+         * @brief Длина строкового представления без построения строки
+         * @return Количество символов, которое запишет format_to()
          */
-        void parse_string(const std::string& str);
+        size_t formatted_size() const;
+
+        /**
+         * @brief Записать строковое представление в буфер
+         *
+         * Формат совпадает с to_string(); завершающий '\0' не пишется.
+         * Буфер должен вмещать formatted_size() символов.
+         *
+         * @param out Начало буфера
+         * @return Указатель за последним записанным символом
+         */
+        char* format_to(char* out) const;
+
+        /**
+         * @brief Записать строковое представление в выходной итератор
+         * @param out Итератор вывода символов
+         * @return Итератор за последним записанным символом
+         */
+        template <typename OutputIt>
+        OutputIt format_to(OutputIt out) const {
+            return view().format_to(out);
+        }
 
         /**
-         * @brief Оператор вывода в поток
+         * @brief Парсинг строкового представления
+         *
+         * Принимает "[a0]", "[a0; a1, a2, ...]" и периодическую запись
+         * "[a0; a1, (a2, a3)]", которую выдает to_string(). После a0
+         * разделителями могут быть ';' и ','; пробелы допускаются везде.
+         * Память выделяется только под коэффициенты (буфер переиспользуется).
+         * При ошибке дробь становится равной [0].
+         *
+         * @param str Строка для парсинга
+         * @throw ParseError При неверном формате (с позицией ошибки)
          */
-        friend std::ostream& operator<<(std::ostream& os, const ContinuedFraction& cf);
+        void parse_string(std::string_view str);
 
         /**
-         * @brief Оператор ввода из потока
+         * @brief Создать цепную дробь из строкового представления
+         * @param str Строка в формате parse_string()
+         * @return Цепная дробь
+         * @throw ParseError При неверном формате
          */
-        friend std::istream& operator>>(std::istream& is, ContinuedFraction& cf);
+        static ContinuedFraction from_string(std::string_view str);
 
         // ==================== СТАТИЧЕСКИЕ МЕТОДЫ ====================
 
         /**
          * @brief Создать цепную дробь из десятичного числа
+         *
+         * Значение double раскладывается точно, как двоичная дробь m·2ᵉ:
+         * результат - первые max_terms коэффициентов этой дроби.
+         *
          * @param value Десятичное число
          * @param max_terms Максимальное количество коэффициентов
+         * @param alloc Распределитель памяти
          * @return Цепная дробь
+         * @throw std::invalid_argument Для бесконечности и NaN
+         * @throw std::overflow_error Если коэффициент не помещается в long long
+         *        (|value| ≥ 2⁶³)
          */
-        static ContinuedFraction from_double(double value, size_t max_terms = 20);
+        static ContinuedFraction from_double(double value, size_t max_terms = 20,
+                                             const allocator_type& alloc = {});
 
         /**
          * @brief Создать цепную дробь из рационального числа
          * @param numerator Числитель
          * @param denominator Знаменатель
+         * @param alloc Распределитель памяти
          * @return Цепная дробь
          * @throw std::invalid_argument При нулевом знаменателе
          */
-        static ContinuedFraction from_rational(long long numerator, long long denominator);
+        static ContinuedFraction from_rational(long long numerator, long long denominator,
+                                               const allocator_type& alloc = {});
+
+        /**
+         * @brief Создать цепную дробь из рационального числа произвольной точности
+         * @param numerator Числитель
+         * @param denominator Знаменатель
+         * @param alloc Распределитель памяти
+         * @return Цепная дробь
+         * @throw std::invalid_argument При нулевом знаменателе
+         * @throw std::overflow_error Если коэффициент не помещается в long long
+         */
+        static ContinuedFraction from_rational(const BigInt& numerator, const BigInt& denominator,
+                                               const allocator_type& alloc = {});
+
+        /**
+         * @brief Создать дробь из готового буфера коэффициентов без копирования
+         *
+         * Буфер перемещается в дробь вместе со своим распределителем
+         * и нормализуется.
+         *
+         * @param coeffs Коэффициенты (пустой буфер дает [0])
+         * @param period_start Индекс начала периода или npos
+         * @return Цепная дробь
+         */
+        static ContinuedFraction from_coefficients(Coefficients&& coeffs, size_t period_start = npos);
 
         /**
          * @brief Создать периодическую цепную дробь
          * @param non_periodic Непериодическая часть
          * @param periodic Периодическая часть
+         * @param alloc Распределитель памяти
          * @return Периодическая цепная дробь
          */
         static ContinuedFraction create_periodic(
             const std::vector<long long>& non_periodic,
-            const std::vector<long long>& periodic);
+            const std::vector<long long>& periodic,
+            const allocator_type& alloc = {});
 
         // ==================== СВОЙСТВА ====================
 
         /**
          * @brief Проверить конечность дроби
          */
-        bool is_finite() const;
+        bool is_finite() const noexcept { return period_start_ == npos; }
 
         /**
          * @brief Проверить периодичность дроби
          */
-        bool is_periodic() const;
+        bool is_periodic() const noexcept { return period_start_ != npos; }
 
         /**
          * @brief Получить количество коэффициентов
          */
-        size_t size() const;
+        size_t size() const noexcept { return coefficients_.size(); }
+
+        /**
+         * @brief Получить индекс начала периода
+         * @return Индекс первого коэффициента периода или npos
+         */
+        size_t period_start() const noexcept { return period_start_; }
 
         /**
          * @brief Проверить, является ли дробь целым числом
          */
-        bool is_integer() const;
+        bool is_integer() const noexcept { return coefficients_.size() == 1; }
 
         /**
          * @brief Очистить цепную дробь
@@ -374,12 +828,36 @@ namespace Math {
 
     /**
      * @brief Вычислить цепную дробь для квадратного корня
+     *
+     * Разложение строится в целых числах (⌊√n⌋ без std::sqrt) до конца
+     * периода: √n = [a₀; (a₁, ..., aᵣ)]. Если период длиннее max_terms,
+     * возвращается конечная дробь из a₀ и первых max_terms коэффициентов,
+     * а *truncated (если передан) становится true. Полные разложения
+     * запоминаются, и повторный запрос того же n не пересчитывается.
+     *
      * @param n Число, из которого извлекается корень
-     * @param max_terms Максимальное количество коэффициентов
+     * @param max_terms Предельная длина периода (npos - без ограничения)
+     * @param truncated Признак того, что период не уместился в max_terms
      * @return Цепная дробь для √n
      * @throw std::invalid_argument При отрицательном n
      */
-    ContinuedFraction sqrt_continued_fraction(long long n, size_t max_terms = 20);
+    ContinuedFraction sqrt_continued_fraction(long long n,
+                                              size_t max_terms = ContinuedFraction::npos,
+                                              bool* truncated = nullptr);
+
+    /**
+     * @brief Полное разложение √n из общего кэша без копирования
+     *
+     * Потокобезопасно; объем кэша ограничен, при переполнении
+     * он очищается (выданные указатели остаются действительными).
+     * Кэши экземпляра заполнены заранее (warm_caches()), поэтому его
+     * константные методы можно вызывать из нескольких потоков.
+     *
+     * @param n Число, из которого извлекается корень
+     * @return Разложение [a₀; (a₁, ..., aᵣ)] или [a₀] для полного квадрата
+     * @throw std::invalid_argument При отрицательном n
+     */
+    std::shared_ptr<const ContinuedFraction> cached_sqrt_continued_fraction(long long n);
 
     /**
      * @brief Вычислить цепную дробь для числа e
@@ -390,11 +868,31 @@ namespace Math {
 
     /**
      * @brief Вычислить цепную дробь для числа π
-     * @param max_terms Максимальное количество коэффициентов
+     *
+     * Все коэффициенты точны; это начальный отрезок бесконечного
+     * разложения [3; 7, 15, 1, 292, ...], а не разложение double.
+     *
+     * @param max_terms Количество коэффициентов
      * @return Приближение π цепной дробью
+     * @throw std::overflow_error Если коэффициент не помещается в long long
      */
     ContinuedFraction pi_continued_fraction(size_t max_terms = 20);
 
+    /**
+     * @brief Наилучшее рациональное приближение числа double
+     *
+     * Совпадает с from_double(value, npos).best_rational(max_denominator):
+     * используется точное значение value, поэтому результат не зависит
+     * от ошибок округления промежуточных вычислений.
+     *
+     * @param value Конечное значение
+     * @param max_denominator Наибольший допустимый знаменатель (≥ 1)
+     * @return Пара {числитель, знаменатель}
+     * @throw std::invalid_argument При max_denominator < 1, бесконечности или NaN
+     * @throw std::overflow_error Если числитель не помещается в long long
+     */
+    std::pair<long long, long long> best_rational(double value, long long max_denominator);
+
     // ==================== INLINE-ФУНКЦИИ ====================
 
     /**
@@ -403,13 +901,13 @@ namespace Math {
      * @param b Второе число
      * @return Наибольший общий делитель
      */
-    inline long long gcd(long long a, long long b) {
+    constexpr long long gcd(long long a, long long b) {
         while (b != 0) {
             long long temp = b;
             b = a % b;
             a = temp;
         }
-        return std::abs(a);
+        return a < 0 ? -a : a;
     }
 
     /**
@@ -426,4 +924,14 @@ namespace Math {
     }
 }
 
+/**
+ * @brief Хеш для неупорядоченных контейнеров (см. ContinuedFraction::hash())
+ */
+template <>
+struct std::hash<Math::ContinuedFraction> {
+    size_t operator()(const Math::ContinuedFraction& cf) const {
+        return static_cast<size_t>(cf.hash());
+    }
+};
+
 #endif // CONTINUED_FRACTION_H
\ No newline at end of file
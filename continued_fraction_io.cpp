@@ -0,0 +1,222 @@
+/**
+ * @file continued_fraction_io.cpp
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Разбор строкового представления и потоковый ввод/вывод цепных дробей
+ */
+
+#include "continued_fraction_io.h"
+#include "coefficient_stream.h"
+#include <charconv>
+#include <istream>
+#include <ostream>
+#include <string>
+
+namespace Math {
+    namespace {
+        /**
+         * @class FractionParser
+         * @brief Однопроходный разбор "[a0; a1, (a2, ...)]" без регулярных выражений
+         *
+         * Числа читаются std::from_chars, который не зависит от локали
+         * и не выделяет память.
+         */
+        class FractionParser {
+        public:
+            explicit FractionParser(std::string_view text) : text_(text), pos_(0) {}
+
+            /**
+             * @brief Разобрать строку в буфер коэффициентов
+             * @param coeffs Выходной буфер (предварительно очищенный)
+             * @param period_start Начало периода или npos
+             * @throw ParseError при ошибке
+             */
+            void parse(ContinuedFraction::Coefficients& coeffs, size_t& period_start) {
+                skip_spaces();
+                expect('[', "Ожидался символ '['");
+
+                bool in_period = false;
+                bool closed_period = false;
+                while (true) {
+                    skip_spaces();
+                    if (!in_period && !closed_period && peek() == '(') {
+                        ++pos_;
+                        in_period = true;
+                        period_start = coeffs.size();
+                        skip_spaces();
+                    }
+
+                    coeffs.push_back(read_integer());
+                    skip_spaces();
+
+                    if (in_period && peek() == ')') {
+                        ++pos_;
+                        in_period = false;
+                        closed_period = true;
+                        skip_spaces();
+                    }
+
+                    const char ch = peek();
+                    if (ch == ']') {
+                        ++pos_;
+                        break;
+                    }
+                    if (closed_period) {
+                        fail("Период должен завершать цепную дробь");
+                    }
+                    if (ch != ';' && ch != ',') {
+                        fail("Ожидался разделитель ';' или ','");
+                    }
+                    ++pos_;
+                }
+
+                if (in_period) {
+                    fail("Не закрыта скобка периода");
+                }
+
+                skip_spaces();
+                if (pos_ != text_.size()) {
+                    fail("Лишние символы после ']'");
+                }
+            }
+
+        private:
+            char peek() const {
+                return pos_ < text_.size() ? text_[pos_] : '\0';
+            }
+
+            void skip_spaces() {
+                while (pos_ < text_.size() &&
+                       (text_[pos_] == ' ' || text_[pos_] == '\t' ||
+                        text_[pos_] == '\r' || text_[pos_] == '\n')) {
+                    ++pos_;
+                }
+            }
+
+            void expect(char ch, const char* message) {
+                if (peek() != ch) {
+                    fail(message);
+                }
+                ++pos_;
+            }
+
+            long long read_integer() {
+                const char* first = text_.data() + pos_;
+                const char* last = text_.data() + text_.size();
+                if (first != last && *first == '+') {
+                    ++first;
+                }
+
+                long long value = 0;
+                const auto [ptr, ec] = std::from_chars(first, last, value);
+                if (ec == std::errc::result_out_of_range) {
+                    fail("Коэффициент вне диапазона long long");
+                }
+                if (ec != std::errc()) {
+                    fail("Ожидался целый коэффициент");
+                }
+                pos_ = static_cast<size_t>(ptr - text_.data());
+                return value;
+            }
+
+            [[noreturn]] void fail(const char* message) const {
+                throw ParseError(std::string("Неверный формат цепной дроби: ") + message, pos_);
+            }
+
+            std::string_view text_;   ///< Разбираемая строка
+            size_t pos_;              ///< Текущая позиция
+        };
+    }
+
+    /**
+     * @brief Парсинг строки
+     * @param str Строка для парсинга
+     * @throw ParseError при ошибке
+     *
+     * Поддерживает форматы:
+     * - [a0]
+     * - [a0; a1, a2, ...] (разделители ';' и ',')
+     * - [a0; (a1, a2, ...)] и [a0; a1, (a2, ...)]
+     */
+    void ContinuedFraction::parse_string(std::string_view str) {
+        coefficients_.clear();
+        period_start_ = npos;
+
+        try {
+            FractionParser(str).parse(coefficients_, period_start_);
+        } catch (const ParseError&) {
+            coefficients_.assign(1, 0);
+            period_start_ = npos;
+            invalidate_cache();
+            throw;
+        }
+
+        normalize();
+    }
+
+    /**
+     * @brief Создание из строки
+     * @param str Строковое представление
+     * @return Цепная дробь
+     */
+    ContinuedFraction ContinuedFraction::from_string(std::string_view str) {
+        ContinuedFraction cf;
+        cf.parse_string(str);
+        return cf;
+    }
+
+    /**
+     * @brief Оператор вывода
+     */
+    std::ostream& operator<<(std::ostream& os, const ContinuedFraction& cf) {
+        return os << cf.view();
+    }
+
+    /**
+     * @brief Оператор ввода
+     *
+     * Строка разбирается по мере чтения CoefficientStreamReader без
+     * промежуточной копии: istream::getline() переносит символы до '\n'
+     * блоками в буфер на стеке. При ошибке остаток строки пропускается,
+     * а cf становится [0].
+     */
+    std::istream& operator>>(std::istream& is, ContinuedFraction& cf) {
+        // Блок на стеке: operator>> вызывается для каждой строки ввода
+        constexpr size_t LINE_CHUNK_SIZE = 256;
+
+        const std::istream::sentry sentry(is, true);
+        bool line_done = !sentry;
+        auto line_source = [&is, &line_done](char* buffer, size_t size) -> size_t {
+            if (line_done) {
+                return 0;
+            }
+
+            // getline() дописывает '\0', поэтому в блок помещается size - 1 символов;
+            // failbit без eofbit означает, что строка длиннее блока
+            is.getline(buffer, static_cast<std::streamsize>(size));
+            const size_t count = static_cast<size_t>(is.gcount());
+            const bool more = is.fail() && !is.eof();
+            is.clear(is.rdstate() & ~std::ios::failbit);
+            if (more) {
+                return count;
+            }
+            line_done = true;
+            return is.eof() ? count : count - 1;   // '\n' учтен в gcount()
+        };
+
+        char chunk[LINE_CHUNK_SIZE];
+        CoefficientStreamReader reader(line_source, chunk);
+        try {
+            cf = reader.read();
+            if (!reader.at_end()) {
+                throw ParseError("Неверный формат цепной дроби: Лишние символы после ']'",
+                                 reader.offset());
+            }
+        } catch (const ParseError&) {
+            while (line_source(chunk, sizeof(chunk)) != 0) {}
+            cf = ContinuedFraction();
+            throw;
+        }
+        return is;
+    }
+}
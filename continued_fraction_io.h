@@ -0,0 +1,64 @@
+/**
+ * @file continued_fraction_io.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Потоковый ввод/вывод и std::format для цепных дробей
+ *
+ * Отделен от continued_fraction.h, чтобы единицы трансляции, которым
+ * нужна только арифметика, не подключали потоки и <format>.
+ * Разбор строк (ContinuedFraction::parse_string, from_string)
+ * реализован в continued_fraction_io.cpp.
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef CONTINUED_FRACTION_IO_H
+#define CONTINUED_FRACTION_IO_H
+
+#include "continued_fraction.h"
+#include <iosfwd>
+#include <version>
+#if defined(__cpp_lib_format)
+#include <format>
+#endif
+
+namespace Math {
+    /**
+     * @brief Оператор вывода в поток (формат to_string())
+     */
+    std::ostream& operator<<(std::ostream& os, const ContinuedFraction& cf);
+
+    /**
+     * @brief Оператор ввода из потока
+     *
+     * Разбирает одну строку в формате parse_string() по мере чтения,
+     * без промежуточной копии (см. CoefficientStreamReader).
+     *
+     * @throw ParseError При неверном формате
+     */
+    std::istream& operator>>(std::istream& is, ContinuedFraction& cf);
+}
+
+#if defined(__cpp_lib_format)
+/**
+ * @brief Поддержка std::format для цепных дробей
+ *
+ * Спецификация формата не поддерживается: "{}" дает то же, что to_string().
+ */
+template <>
+struct std::formatter<Math::ContinuedFraction, char> {
+    constexpr auto parse(std::format_parse_context& ctx) {
+        auto it = ctx.begin();
+        if (it != ctx.end() && *it != '}') {
+            throw std::format_error("Цепная дробь не поддерживает спецификацию формата");
+        }
+        return it;
+    }
+
+    auto format(const Math::ContinuedFraction& cf, std::format_context& ctx) const {
+        return cf.format_to(ctx.out());
+    }
+};
+#endif
+
+#endif // CONTINUED_FRACTION_IO_H
@@ -0,0 +1,404 @@
+/**
+ * @file continued_fraction_view.cpp
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Реализация невладеющего представления цепной дроби
+ *
+ * Здесь находятся алгоритмы, которым достаточно коэффициентов
+ * только для чтения; ContinuedFraction делегирует им свою работу.
+ */
+
+#include "continued_fraction_view.h"
+#include "checked_arithmetic.h"
+#include "matrix_product.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+
+namespace Math {
+    // ==================== ВЫЧИСЛЕНИЯ ====================
+
+    namespace {
+        /**
+         * @brief Коэффициентов за предпериодом при вычислении значения
+         *        нерегулярной периодической дроби последовательным приближением
+         */
+        constexpr size_t PERIODIC_FALLBACK_TERMS = 128;
+
+        /**
+         * @struct Mobius
+         * @brief Дробно-линейное отображение x ↦ (p·x + p')/(q·x + q')
+         *
+         * После применения коэффициентов a₀, ..., aₖ это матрица
+         * [[pₖ, pₖ₋₁], [qₖ, qₖ₋₁]]. Отображение не меняется при умножении
+         * всех элементов на одно число, поэтому при росте элементов они
+         * масштабируются степенью двойки (без потери точности).
+         */
+        struct Mobius {
+            long double p = 1, p_prev = 0;
+            long double q = 0, q_prev = 1;
+
+            /**
+             * @brief Домножить справа на [[a, 1], [1, 0]]
+             */
+            void push(long long a) {
+                const long double coeff = static_cast<long double>(a);
+                const long double new_p = coeff * p + p_prev;
+                const long double new_q = coeff * q + q_prev;
+                p_prev = p; q_prev = q;
+                p = new_p; q = new_q;
+
+                constexpr long double LIMIT = 0x1p256L;
+                if (std::fabs(p) > LIMIT || std::fabs(q) > LIMIT) {
+                    p = std::ldexp(p, -256); p_prev = std::ldexp(p_prev, -256);
+                    q = std::ldexp(q, -256); q_prev = std::ldexp(q_prev, -256);
+                }
+            }
+
+            /**
+             * @brief Значение отображения в точке x
+             */
+            long double apply(long double x) const {
+                return (p * x + p_prev) / (q * x + q_prev);
+            }
+        };
+    }
+
+    /**
+     * @brief Вычисление значения
+     *
+     * Конечная дробь вычисляется обходом с конца для численной
+     * устойчивости. Для периодической дроби [a₀; ...; aₛ₋₁; (b₀, ..., bᵣ₋₁)]
+     * хвост y = [(b₀, ..., bᵣ₋₁)] удовлетворяет y = (P·y + P')/(Q·y + Q'),
+     * где [[P, P'], [Q, Q']] - произведение матриц периода, то есть
+     * Q·y² + (Q' - P)·y - P' = 0. При положительных bᵢ нужный корень -
+     * положительный (y > 1), второй отрицателен; он вычисляется формулой
+     * без вычитания близких чисел. Затем к y применяется отображение
+     * предпериода. Если период содержит неположительные коэффициенты,
+     * выбор корня не гарантирован, и значение вычисляется подходящей
+     * дробью по PERIODIC_FALLBACK_TERMS коэффициентам после предпериода.
+     */
+    double ContinuedFractionView::to_double() const {
+        if (is_finite()) {
+            if (coefficients_.empty()) {
+                return 0.0;
+            }
+            // Нулевой промежуточный остаток дает 1/0 = ∞, и следующий
+            // шаг корректно возвращает a + 1/∞ = a
+            auto it = coefficients_.rbegin();
+            double value = static_cast<double>(*it);
+            for (++it; it != coefficients_.rend(); ++it) {
+                value = static_cast<double>(*it) + 1.0 / value;
+            }
+            return value;
+        }
+
+        const std::span<const long long> period = coefficients_.subspan(period_start_);
+        const bool regular = std::all_of(period.begin(), period.end(),
+                                         [](long long b) { return b > 0; });
+
+        Mobius prefix;
+        for (size_t i = 0; i < period_start_; ++i) {
+            prefix.push(coefficients_[i]);
+        }
+
+        if (regular) {
+            Mobius cycle;
+            for (long long b : period) {
+                cycle.push(b);
+            }
+
+            const long double t = cycle.p - cycle.q_prev;
+            const long double discriminant = t * t + 4 * cycle.q * cycle.p_prev;
+            const long double root = std::sqrt(discriminant);
+            const long double tail = t >= 0
+                ? (t + root) / (2 * cycle.q)
+                : (2 * cycle.p_prev) / (root - t);
+            return static_cast<double>(prefix.apply(tail));
+        }
+
+        for (size_t i = period_start_; i < period_start_ + PERIODIC_FALLBACK_TERMS; ++i) {
+            prefix.push(coefficient_at(i));
+        }
+        return static_cast<double>(prefix.p / prefix.q);
+    }
+
+    /**
+     * @brief Подходящая дробь по рекуррентным формулам
+     *
+     * pᵢ = aᵢ·pᵢ₋₁ + pᵢ₋₂, qᵢ = aᵢ·qᵢ₋₁ + qᵢ₋₂ (по модулю 2⁶⁴)
+     */
+    std::pair<long long, long long> ContinuedFractionView::convergent(size_t n) const {
+        if (n >= size() && is_finite()) {
+            throw std::out_of_range("Индекс подходящей дроби вне диапазона");
+        }
+
+        long long prev_num = 1, prev_den = 0;
+        long long curr_num = coefficient_at(0), curr_den = 1;
+        for (size_t i = 1; i <= n; ++i) {
+            const long long coeff = coefficient_at(i);
+            const long long new_num = detail::wrapping_mul_add(coeff, curr_num, prev_num);
+            const long long new_den = detail::wrapping_mul_add(coeff, curr_den, prev_den);
+            prev_num = curr_num; prev_den = curr_den;
+            curr_num = new_num; curr_den = new_den;
+        }
+        return {curr_num, curr_den};
+    }
+
+    /**
+     * @brief Подходящая дробь с контролем переполнения
+     */
+    std::pair<long long, long long> ContinuedFractionView::checked_convergent(size_t n) const {
+        if (n >= size() && is_finite()) {
+            throw std::out_of_range("Индекс подходящей дроби вне диапазона");
+        }
+
+        long long prev_num = 1, prev_den = 0;
+        long long curr_num = coefficient_at(0), curr_den = 1;
+        for (size_t i = 1; i <= n; ++i) {
+            const long long coeff = coefficient_at(i);
+            long long new_num, new_den;
+            if (!detail::checked_mul_add(coeff, curr_num, prev_num, new_num) ||
+                !detail::checked_mul_add(coeff, curr_den, prev_den, new_den)) {
+                throw std::overflow_error("Переполнение long long в подходящей дроби с индексом " +
+                                          std::to_string(i));
+            }
+            prev_num = curr_num; prev_den = curr_den;
+            curr_num = new_num; curr_den = new_den;
+        }
+        return {curr_num, curr_den};
+    }
+
+    // ==================== СРАВНЕНИЕ ====================
+
+    namespace {
+        /**
+         * @brief Коэффициенты дроби в каноническом виде для сравнения
+         *
+         * Пустое представление - это [0]; у конечной дроби хвост [..., a, 1]
+         * читается как [..., a + 1].
+         */
+        class CanonicalTerms {
+        public:
+            explicit CanonicalTerms(const ContinuedFractionView& view)
+                : view_(view), size_(view.is_finite() ? std::max<size_t>(view.size(), 1) : 0)
+                , merged_(false) {
+                if (view.is_finite() && view.size() > 1 && view.coefficients().back() == 1 &&
+                    view.coefficients()[view.size() - 2] < std::numeric_limits<long long>::max()) {
+                    --size_;
+                    merged_ = true;
+                }
+            }
+
+            /**
+             * @brief Коэффициент j или std::nullopt, если дробь закончилась
+             */
+            std::optional<long long> operator[](size_t j) const {
+                if (view_.is_finite() && j >= size_) {
+                    return std::nullopt;
+                }
+                const long long term = view_.coefficient_at(j);
+                return merged_ && j + 1 == size_ ? term + 1 : term;
+            }
+
+        private:
+            const ContinuedFractionView& view_;
+            size_t size_;    ///< Количество коэффициентов конечной дроби
+            bool merged_;    ///< Последняя единица прибавлена к предыдущему коэффициенту
+        };
+
+        /**
+         * @brief Все ли коэффициенты, кроме a₀, положительны
+         *
+         * У периодической дроби с началом периода 0 коэффициент a₀
+         * повторяется в периоде и тоже должен быть положительным.
+         */
+        bool is_regular(const ContinuedFractionView& view) {
+            const std::span<const long long> coeffs = view.coefficients();
+            const size_t first = view.period_start() == 0 ? 0 : 1;
+            return coeffs.size() <= first ||
+                   std::all_of(coeffs.begin() + static_cast<std::ptrdiff_t>(first), coeffs.end(),
+                               [](long long c) { return c > 0; });
+        }
+
+        /**
+         * @brief Точное значение конечной дроби p/q со знаменателем q ≥ 0
+         */
+        std::pair<BigInt, BigInt> exact_value(const ContinuedFractionView& view) {
+            if (view.size() == 0) {
+                return {0, 1};
+            }
+            auto [p, q] = tree_convergent(view, view.size() - 1, 1);
+            if (q.is_negative()) {
+                return {-p, -q};
+            }
+            return {std::move(p), std::move(q)};
+        }
+
+        /**
+         * @brief Сравнение значений нерегулярных дробей
+         */
+        std::weak_ordering compare_values(const ContinuedFractionView& a, const ContinuedFractionView& b) {
+            if (a.is_finite() && b.is_finite()) {
+                const auto [pa, qa] = exact_value(a);
+                const auto [pb, qb] = exact_value(b);
+                if (!qa.is_zero() && !qb.is_zero()) {
+                    return pa * qb <=> pb * qa;
+                }
+            }
+
+            const double x = a.to_double();
+            const double y = b.to_double();
+            if (x < y) {
+                return std::weak_ordering::less;
+            }
+            return x > y ? std::weak_ordering::greater : std::weak_ordering::equivalent;
+        }
+    }
+
+    /**
+     * @brief Лексикографическое сравнение с чередованием знака
+     */
+    std::weak_ordering operator<=>(const ContinuedFractionView& a, const ContinuedFractionView& b) {
+        if (!is_regular(a) || !is_regular(b)) {
+            return compare_values(a, b);
+        }
+
+        const CanonicalTerms terms_a(a);
+        const CanonicalTerms terms_b(b);
+
+        size_t limit = ContinuedFractionView::npos;
+        if (a.is_periodic() && b.is_periodic()) {
+            limit = std::max(a.period_start(), b.period_start()) +
+                    (a.size() - a.period_start()) + (b.size() - b.period_start());
+        }
+
+        for (size_t j = 0; j < limit; ++j) {
+            const std::optional<long long> x = terms_a[j];
+            const std::optional<long long> y = terms_b[j];
+            if (!x && !y) {
+                return std::weak_ordering::equivalent;
+            }
+            if (x && y && *x == *y) {
+                continue;
+            }
+
+            // Закончившаяся дробь ведет себя как коэффициент +∞
+            const std::weak_ordering order = !x ? std::weak_ordering::greater
+                                             : !y ? std::weak_ordering::less
+                                             : std::weak_ordering(*x <=> *y);
+            return j % 2 == 0 ? order : 0 <=> order;
+        }
+        return std::weak_ordering::equivalent;
+    }
+
+    // ==================== ФОРМАТИРОВАНИЕ ====================
+
+    namespace {
+        /**
+         * @brief Количество символов десятичной записи числа (со знаком)
+         */
+        size_t decimal_length(long long value) {
+            // Модуль через unsigned, чтобы не переполниться на LLONG_MIN
+            unsigned long long magnitude = value < 0
+                ? 0ULL - static_cast<unsigned long long>(value)
+                : static_cast<unsigned long long>(value);
+            size_t length = value < 0 ? 2 : 1;
+            while (magnitude >= 10) {
+                magnitude /= 10;
+                ++length;
+            }
+            return length;
+        }
+    }
+
+    std::string ContinuedFractionView::to_string() const {
+        std::string result(formatted_size(), '\0');
+        format_to(result.data());
+        return result;
+    }
+
+    /**
+     * @brief Длина строкового представления
+     *
+     * Считается без форматирования: сумма длин коэффициентов,
+     * разделителей "; " и скобок.
+     */
+    size_t ContinuedFractionView::formatted_size() const {
+        if (coefficients_.empty()) {
+            return 3;   // "[0]"
+        }
+
+        size_t length = 2 + 2 * (coefficients_.size() - 1);   // "[", "]" и "; "
+        for (long long coeff : coefficients_) {
+            length += decimal_length(coeff);
+        }
+        if (period_start_ != npos) {
+            length += 2;   // "(" и ")"
+        }
+        return length;
+    }
+
+    /**
+     * @brief Запись строкового представления в буфер
+     */
+    char* ContinuedFractionView::format_to(char* out) const {
+        if (coefficients_.empty()) {
+            *out++ = '[';
+            *out++ = '0';
+            *out++ = ']';
+            return out;
+        }
+
+        for (size_t i = 0; i < coefficients_.size(); ++i) {
+            out = format_term(i, out);
+        }
+        return out;
+    }
+
+    /**
+     * @brief Запись одного коэффициента с окружающей разметкой
+     *
+     * Перед коэффициентом пишется "[" или "; ", перед началом периода - "(",
+     * после последнего коэффициента - ")]" или "]".
+     */
+    char* ContinuedFractionView::format_term(size_t i, char* out) const {
+        if (i == 0) {
+            *out++ = '[';
+        } else {
+            *out++ = ';';
+            *out++ = ' ';
+        }
+        if (i == period_start_) {
+            *out++ = '(';
+        }
+
+        // 20 знаков хватает для любого long long вместе со знаком
+        out = std::to_chars(out, out + 20, coefficients_[i]).ptr;
+
+        if (i + 1 == coefficients_.size()) {
+            if (period_start_ != npos) {
+                *out++ = ')';
+            }
+            *out++ = ']';
+        }
+        return out;
+    }
+
+    /**
+     * @brief Вывод в поток без промежуточной строки
+     */
+    std::ostream& operator<<(std::ostream& os, const ContinuedFractionView& view) {
+        if (os.width() != 0) {
+            // Выравнивание по ширине требует готовой строки
+            return os << view.to_string();
+        }
+        view.format_to(std::ostreambuf_iterator<char>(os));
+        return os;
+    }
+}
@@ -0,0 +1,229 @@
+/**
+ * @file continued_fraction_view.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Невладеющее представление цепной дроби
+ *
+ * ContinuedFractionView ссылается на коэффициенты, которые хранятся
+ * в чужом буфере (в ContinuedFraction, в массиве вызывающего кода,
+ * в декодированной записи архива), и позволяет вычислять значение,
+ * подходящие дроби, сравнивать и форматировать дробь без копирования.
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef CONTINUED_FRACTION_VIEW_H
+#define CONTINUED_FRACTION_VIEW_H
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <iosfwd>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace Math {
+    /**
+     * @class ContinuedFractionView
+     * @brief Лёгкое представление [a0; a1, ...] над std::span<const long long>
+     *
+     * Представление не нормализует коэффициенты и не владеет ими:
+     * буфер должен жить дольше представления. Пустой диапазон
+     * соответствует дроби [0].
+     */
+    class ContinuedFractionView {
+    public:
+        /**
+         * @brief Значение "нет периода"
+         */
+        static constexpr size_t npos = static_cast<size_t>(-1);
+
+        // ==================== КОНСТРУКТОРЫ ====================
+
+        /**
+         * @brief Пустое представление (дробь [0])
+         */
+        constexpr ContinuedFractionView() noexcept : period_start_(npos) {}
+
+        /**
+         * @brief Представление над диапазоном коэффициентов
+         * @param coeffs Коэффициенты a0, a1, ...
+         * @param period_start Индекс начала периода или npos
+         */
+        constexpr ContinuedFractionView(std::span<const long long> coeffs,
+                                        size_t period_start = npos) noexcept
+            : coefficients_(coeffs)
+            , period_start_(period_start < coeffs.size() ? period_start : npos) {}
+
+        // ==================== СВОЙСТВА ====================
+
+        std::span<const long long> coefficients() const noexcept { return coefficients_; }
+        size_t size() const noexcept { return coefficients_.size(); }
+        size_t period_start() const noexcept { return period_start_; }
+        bool is_periodic() const noexcept { return period_start_ != npos; }
+        bool is_finite() const noexcept { return period_start_ == npos; }
+
+        /**
+         * @brief Коэффициент с учетом периода
+         *
+         * За концом хранимых коэффициентов периодической дроби повторяется
+         * только период [period_start(), size()), но не предпериод.
+         *
+         * @param i Индекс коэффициента (для периодической дроби - любой)
+         * @throw std::out_of_range При i ≥ size() у непустой конечной дроби
+         */
+        long long coefficient_at(size_t i) const {
+            if (i < coefficients_.size()) {
+                return coefficients_[i];
+            }
+            if (coefficients_.empty()) {
+                return 0;
+            }
+            if (is_finite()) {
+                throw std::out_of_range("Индекс коэффициента вне диапазона");
+            }
+            const size_t period = coefficients_.size() - period_start_;
+            return coefficients_[period_start_ + (i - period_start_) % period];
+        }
+
+        // ==================== ВЫЧИСЛЕНИЯ ====================
+
+        /**
+         * @brief Приближенное значение дроби
+         *
+         * Значение периодической дроби - квадратичная иррациональность -
+         * вычисляется в замкнутом виде за O(длины дроби): хвост y = [(период)]
+         * является неподвижной точкой дробно-линейного отображения периода,
+         * то есть корнем квадратного уравнения.
+         */
+        double to_double() const;
+
+        /**
+         * @brief n-я подходящая дробь
+         *
+         * Вычисляется без кэша за O(n); при переполнении значения
+         * берутся по модулю 2⁶⁴, как в ContinuedFraction::convergent().
+         *
+         * @throw std::out_of_range При n ≥ size() у конечной дроби
+         */
+        std::pair<long long, long long> convergent(size_t n) const;
+
+        /**
+         * @brief n-я подходящая дробь с контролем переполнения
+         * @throw std::out_of_range При n ≥ size() у конечной дроби
+         * @throw std::overflow_error Если значение не помещается в long long
+         */
+        std::pair<long long, long long> checked_convergent(size_t n) const;
+
+        // ==================== СРАВНЕНИЕ ====================
+
+        /**
+         * @brief Совпадение коэффициентов и начала периода
+         */
+        friend bool operator==(const ContinuedFractionView& a, const ContinuedFractionView& b) {
+            return a.period_start_ == b.period_start_ &&
+                   std::equal(a.coefficients_.begin(), a.coefficients_.end(),
+                              b.coefficients_.begin(), b.coefficients_.end());
+        }
+
+        /**
+         * @brief Сравнение значений по коэффициентам
+         *
+         * Для регулярных дробей (aᵢ ≥ 1 при i ≥ 1) значения упорядочены
+         * лексикографически со знаком, чередующимся по индексу: при первом
+         * различии в четной позиции больше та дробь, у которой больше
+         * коэффициент, в нечетной - наоборот; закончившаяся дробь ведет
+         * себя как коэффициент +∞. Просматривается только общий префикс
+         * (для двух периодических дробей - не дальше максимального
+         * предпериода плюс сумма длин периодов: по теореме Файна - Вилфа
+         * совпадение на этом отрезке означает равенство).
+         *
+         * Регулярность проверяется заранее целочисленным просмотром
+         * коэффициентов; нерегулярные конечные дроби сравниваются точно
+         * через подходящие дроби в BigInt, периодические - по to_double().
+         *
+         * Эквивалентность означает равенство значений: [2; 1] и [3]
+         * эквивалентны, хотя operator== их различает, поэтому порядок
+         * слабый (std::weak_ordering).
+         */
+        friend std::weak_ordering operator<=>(const ContinuedFractionView& a,
+                                              const ContinuedFractionView& b);
+
+        friend bool operator<(const ContinuedFractionView& a, const ContinuedFractionView& b) {
+            return (a <=> b) < 0;
+        }
+        friend bool operator<=(const ContinuedFractionView& a, const ContinuedFractionView& b) {
+            return (a <=> b) <= 0;
+        }
+        friend bool operator>(const ContinuedFractionView& a, const ContinuedFractionView& b) {
+            return (a <=> b) > 0;
+        }
+        friend bool operator>=(const ContinuedFractionView& a, const ContinuedFractionView& b) {
+            return (a <=> b) >= 0;
+        }
+
+        // ==================== ФОРМАТИРОВАНИЕ ====================
+
+        /**
+         * @brief Строковое представление "[a0; a1; (a2; a3)]"
+         */
+        std::string to_string() const;
+
+        /**
+         * @brief Длина строкового представления
+         */
+        size_t formatted_size() const;
+
+        /**
+         * @brief Записать строковое представление в буфер
+         *
+         * Завершающий '\0' не пишется; буфер должен вмещать
+         * formatted_size() символов.
+         *
+         * @return Указатель за последним записанным символом
+         */
+        char* format_to(char* out) const;
+
+        /**
+         * @brief Записать строковое представление в выходной итератор
+         * @return Итератор за последним записанным символом
+         */
+        template <typename OutputIt>
+        OutputIt format_to(OutputIt out) const {
+            if (coefficients_.empty()) {
+                constexpr std::string_view zero = "[0]";
+                return std::copy(zero.begin(), zero.end(), out);
+            }
+            char chunk[MAX_FORMATTED_TERM];
+            for (size_t i = 0; i < coefficients_.size(); ++i) {
+                char* end = format_term(i, chunk);
+                out = std::copy(chunk, end, out);
+            }
+            return out;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, const ContinuedFractionView& view);
+
+    private:
+        std::span<const long long> coefficients_;   ///< Коэффициенты (чужой буфер)
+        size_t period_start_;                       ///< Начало периода или npos
+
+        /**
+         * @brief Наибольшая длина фрагмента format_term(): "; (" + 20 знаков + ")]"
+         */
+        static constexpr size_t MAX_FORMATTED_TERM = 32;
+
+        /**
+         * @brief Записать i-й коэффициент вместе с разделителем и скобками
+         * @param i Индекс коэффициента
+         * @param out Буфер не короче MAX_FORMATTED_TERM
+         * @return Указатель за последним записанным символом
+         */
+        char* format_term(size_t i, char* out) const;
+    };
+}
+
+#endif // CONTINUED_FRACTION_VIEW_H
@@ -0,0 +1,62 @@
+/**
+ * @file fraction_pool.cpp
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Реализация пула интернированных цепных дробей
+ */
+
+#include "fraction_pool.h"
+#include <algorithm>
+#include <iterator>
+
+namespace Math {
+    InternedFraction ContinuedFractionPool::intern(const ContinuedFraction& cf) {
+        return intern(cf.canonical());
+    }
+
+    /**
+     * @brief Поиск по хешу и сравнение коэффициентов внутри группы
+     *
+     * Дробь переносится в ресурс по умолчанию: пул живет дольше арены,
+     * в которой она могла быть построена. Каноническая форма и кэши
+     * вычисляются до захвата мьютекса; заполненные кэши делают общий
+     * экземпляр доступным только для чтения.
+     */
+    InternedFraction ContinuedFractionPool::intern(ContinuedFraction&& cf) {
+        ContinuedFraction owned(std::move(cf), ContinuedFraction::allocator_type{});
+        owned.canonicalize();
+        owned.warm_caches();
+        const std::uint64_t key = owned.hash();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<std::shared_ptr<const ContinuedFraction>>& bucket = buckets_[key];
+        for (const std::shared_ptr<const ContinuedFraction>& existing : bucket) {
+            if (*existing == owned) {
+                return InternedFraction(existing);
+            }
+        }
+        bucket.push_back(std::make_shared<const ContinuedFraction>(std::move(owned)));
+        ++size_;
+        return InternedFraction(bucket.back());
+    }
+
+    size_t ContinuedFractionPool::size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return size_;
+    }
+
+    size_t ContinuedFractionPool::release_unused() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t released = 0;
+        for (auto it = buckets_.begin(); it != buckets_.end();) {
+            auto& bucket = it->second;
+            const auto unused = std::remove_if(bucket.begin(), bucket.end(),
+                [](const std::shared_ptr<const ContinuedFraction>& f) { return f.use_count() == 1; });
+            released += static_cast<size_t>(bucket.end() - unused);
+            bucket.erase(unused, bucket.end());
+            it = bucket.empty() ? buckets_.erase(it) : std::next(it);
+        }
+        size_ -= released;
+        return released;
+    }
+}
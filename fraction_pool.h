@@ -0,0 +1,117 @@
+/**
+ * @file fraction_pool.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Пул интернированных цепных дробей
+ *
+ * Пул хранит по одному экземпляру каждого канонического вида.
+ * Дроби с одинаковым каноническим видом, добавленные в пул, получают
+ * дескриптор на один и тот же объект: память под коэффициенты общая,
+ * а сравнение дескрипторов - это сравнение указателей.
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef FRACTION_POOL_H
+#define FRACTION_POOL_H
+
+#include "continued_fraction.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Math {
+    /**
+     * @class InternedFraction
+     * @brief Дескриптор дроби из ContinuedFractionPool
+     *
+     * Дескриптор продлевает жизнь дроби независимо от пула. Кэши общего
+     * экземпляра заполнены при добавлении (warm_caches()), поэтому его
+     * константные методы можно вызывать из нескольких потоков.
+     * Сравнение дескрипторов имеет смысл только для одного пула:
+     * дескрипторы разных пулов равных дробей не равны.
+     */
+    class InternedFraction {
+    public:
+        const ContinuedFraction& operator*() const noexcept { return *fraction_; }
+        const ContinuedFraction* operator->() const noexcept { return fraction_.get(); }
+        const ContinuedFraction& get() const noexcept { return *fraction_; }
+
+        /**
+         * @brief Хеш канонического вида (вычислен при добавлении в пул)
+         */
+        std::uint64_t hash() const { return fraction_->hash(); }
+
+        /**
+         * @brief Сравнение указателей
+         */
+        friend bool operator==(const InternedFraction& a, const InternedFraction& b) noexcept {
+            return a.fraction_ == b.fraction_;
+        }
+
+    private:
+        friend class ContinuedFractionPool;
+
+        explicit InternedFraction(std::shared_ptr<const ContinuedFraction> fraction)
+            : fraction_(std::move(fraction)) {}
+
+        std::shared_ptr<const ContinuedFraction> fraction_;   ///< Общий экземпляр
+    };
+
+    /**
+     * @class ContinuedFractionPool
+     * @brief Потокобезопасный пул канонических цепных дробей
+     */
+    class ContinuedFractionPool {
+    public:
+        /**
+         * @brief Найти или добавить дробь
+         *
+         * Дробь приводится к каноническому виду; если такой вид уже
+         * есть в пуле, возвращается дескриптор существующего экземпляра.
+         */
+        InternedFraction intern(const ContinuedFraction& cf);
+
+        /**
+         * @brief Найти или добавить дробь, переместив её в пул
+         *
+         * Коэффициенты переносятся в ресурс по умолчанию, поэтому дробь
+         * можно строить во временной арене: get_allocator() дроби из пула
+         * всегда возвращает std::pmr::get_default_resource().
+         */
+        InternedFraction intern(ContinuedFraction&& cf);
+
+        /**
+         * @brief Количество различных дробей в пуле
+         */
+        size_t size() const;
+
+        /**
+         * @brief Удалить дроби, на которые не осталось дескрипторов вне пула
+         * @return Количество удаленных дробей
+         */
+        size_t release_unused();
+
+    private:
+        mutable std::mutex mutex_;
+        /// Экземпляры, сгруппированные по хешу канонического вида
+        std::unordered_map<std::uint64_t, std::vector<std::shared_ptr<const ContinuedFraction>>> buckets_;
+        size_t size_ = 0;   ///< Количество экземпляров
+    };
+}
+
+/**
+ * @brief Хеш дескриптора для неупорядоченных контейнеров
+ */
+template <>
+struct std::hash<Math::InternedFraction> {
+    size_t operator()(const Math::InternedFraction& f) const {
+        return static_cast<size_t>(f.hash());
+    }
+};
+
+#endif // FRACTION_POOL_H
@@ -0,0 +1,48 @@
+/**
+ * @file fraction_pool_test.cpp
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Проверка пула: дробь из освобожденной арены остается доступной
+ *
+ * Дробь строится во временном monotonic_buffer_resource и перемещается
+ * в пул; после уничтожения арены коэффициенты читаются через дескриптор.
+ * Под AddressSanitizer обращение к памяти арены было бы use-after-free.
+ *
+ * Лицензия: MIT
+ */
+
+#include "fraction_pool.h"
+#include <cstdio>
+#include <memory_resource>
+#include <vector>
+
+using namespace Math;
+
+int main() {
+    ContinuedFractionPool pool;
+    std::vector<long long> coeffs;
+    for (long long i = 0; i < 50; ++i) {
+        coeffs.push_back(i + 1);
+    }
+
+    InternedFraction handle = [&] {
+        std::pmr::monotonic_buffer_resource arena;
+        ContinuedFraction cf(coeffs, ContinuedFraction::allocator_type(&arena));
+        return pool.intern(std::move(cf));
+    }();
+
+    int failures = 0;
+    if (handle->get_allocator().resource() != std::pmr::get_default_resource()) {
+        std::fprintf(stderr, "дробь из пула использует ресурс арены\n");
+        ++failures;
+    }
+    if (handle->coefficients().size() != coeffs.size() || handle->coefficients()[10] != 11) {
+        std::fprintf(stderr, "коэффициенты дроби из пула повреждены\n");
+        ++failures;
+    }
+    if (pool.intern(ContinuedFraction(coeffs)) != handle) {
+        std::fprintf(stderr, "повторное добавление дало другой экземпляр\n");
+        ++failures;
+    }
+    return failures == 0 ? 0 : 1;
+}
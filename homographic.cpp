@@ -0,0 +1,588 @@
+/**
+ * @file homographic.cpp
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Реализация потоковой арифметики Госпера
+ *
+ * Состояние (a, b, c, d, e, f, g, h) описывает остаток результата
+ * как бигомографическую функцию от хвостов входных дробей.
+ * Коэффициент результата выдаётся, когда целые части всех
+ * существенных "углов" (a/e, b/f, c/g, d/h) совпадают.
+ *
+ * Шаги алгоритма записаны шаблонами над типом состояния: пока
+ * значения помещаются в long long, используется проверяемая машинная
+ * арифметика, после первого переполнения - BigInt.
+ */
+
+#include "homographic.h"
+#include "checked_arithmetic.h"
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Math {
+    namespace {
+        template <typename T>
+        using State = BihomographicStream::State<T>;
+
+        /**
+         * @brief Результат попытки выдать коэффициент
+         */
+        enum class Emit {
+            Pending,    ///< Коэффициент ещё не определён
+            Ready,      ///< Коэффициент выдан
+            Overflow    ///< Не хватает разрядности long long
+        };
+
+        // ---------- Операции над типом состояния ----------
+
+        /**
+         * @brief out = p·s + t
+         * @return false при переполнении
+         */
+        bool mul_add(long long p, long long s, long long t, long long& out) {
+            long long product;
+            return detail::checked_mul(p, s, product) &&
+                   detail::checked_add(product, t, out);
+        }
+
+        bool mul_add(const BigInt& p, const BigInt& s, const BigInt& t, BigInt& out) {
+            out = p * s;
+            out += t;
+            return true;
+        }
+
+        int sign_of(long long value) {
+            return (value > 0) - (value < 0);
+        }
+
+        int sign_of(const BigInt& value) {
+            return value.sign();
+        }
+
+        /**
+         * @brief q = ⌊n/d⌋ (d ≠ 0)
+         * @return false при переполнении
+         */
+        bool floor_quotient(long long n, long long d, long long& q) {
+            if (d == -1 && n == std::numeric_limits<long long>::min()) {
+                return false;
+            }
+            q = detail::floor_div(n, d);
+            return true;
+        }
+
+        bool floor_quotient(const BigInt& n, const BigInt& d, BigInt& q) {
+            BigInt r;
+            BigInt::floor_divmod(n, d, q, r);
+            return true;
+        }
+
+        /**
+         * @brief Отношение n/d как double (бесконечность при d = 0)
+         */
+        double corner_ratio(long long n, long long d) {
+            if (d == 0) {
+                return std::numeric_limits<double>::infinity();
+            }
+            return static_cast<double>(n) / static_cast<double>(d);
+        }
+
+        double corner_ratio(const BigInt& n, const BigInt& d) {
+            if (d.is_zero()) {
+                return std::numeric_limits<double>::infinity();
+            }
+            // Значения за пределами double сначала сдвигаются вправо
+            const size_t bits = std::max(n.bit_length(), d.bit_length());
+            if (bits <= 1000) {
+                return n.to_double() / d.to_double();
+            }
+            const BigInt scale = BigInt::power_of_two(bits - 64);
+            return (n / scale).to_double() / (d / scale).to_double();
+        }
+
+        /**
+         * @brief Расстояние между двумя углами с учётом бесконечностей
+         */
+        double corner_spread(double u, double v) {
+            if (std::isinf(u) || std::isinf(v)) {
+                return std::numeric_limits<double>::infinity();
+            }
+            return std::abs(u - v);
+        }
+
+        // ---------- Шаги алгоритма ----------
+
+        /**
+         * @brief Существенные углы: зависящие только от неисчерпанных входов
+         * @return Количество углов (пар указателей {числитель, знаменатель})
+         */
+        template <typename T>
+        size_t live_corners(const State<T>& s, bool x_done, bool y_done,
+                            std::pair<const T*, const T*> (&corners)[4]) {
+            size_t count = 0;
+            if (!x_done && !y_done) {
+                corners[count++] = {&s.a, &s.e};
+            }
+            if (!x_done) {
+                corners[count++] = {&s.b, &s.f};
+            }
+            if (!y_done) {
+                corners[count++] = {&s.c, &s.g};
+            }
+            corners[count++] = {&s.d, &s.h};
+            return count;
+        }
+
+        /**
+         * @brief Выдача коэффициента q, если целые части всех углов совпадают
+         *
+         * Знаменатели углов должны быть ненулевыми и одного знака.
+         * z = q + 1/z', z' = (e..h) / ((a..d) - q·(e..h))
+         */
+        template <typename T>
+        Emit emit_step(State<T>& s, bool x_done, bool y_done, T& q) {
+            std::pair<const T*, const T*> corners[4];
+            const size_t count = live_corners(s, x_done, y_done, corners);
+
+            const int sign = sign_of(*corners[0].second);
+            for (size_t i = 0; i < count; ++i) {
+                if (sign == 0 || sign_of(*corners[i].second) != sign) {
+                    return Emit::Pending;
+                }
+            }
+
+            if (!floor_quotient(*corners[0].first, *corners[0].second, q)) {
+                return Emit::Overflow;
+            }
+            for (size_t i = 1; i < count; ++i) {
+                T other;
+                if (!floor_quotient(*corners[i].first, *corners[i].second, other)) {
+                    return Emit::Overflow;
+                }
+                if (other != q) {
+                    return Emit::Pending;
+                }
+            }
+
+            const T minus_q = -q;
+            T na, nb, nc, nd;
+            if (!mul_add(minus_q, s.e, s.a, na) || !mul_add(minus_q, s.f, s.b, nb) ||
+                !mul_add(minus_q, s.g, s.c, nc) || !mul_add(minus_q, s.h, s.d, nd)) {
+                return Emit::Overflow;
+            }
+
+            s.a = std::move(s.e); s.b = std::move(s.f);
+            s.c = std::move(s.g); s.d = std::move(s.h);
+            s.e = std::move(na); s.f = std::move(nb);
+            s.g = std::move(nc); s.h = std::move(nd);
+            return Emit::Ready;
+        }
+
+        /**
+         * @brief Подстановка x = p + 1/x':
+         * (a, b, c, d) → (a·p + c, b·p + d, a, b), аналогично для (e, f, g, h)
+         * @return false при переполнении (состояние не меняется)
+         */
+        template <typename T>
+        bool ingest_x_step(State<T>& s, const T& p) {
+            T na, nb, ne, nf;
+            if (!mul_add(p, s.a, s.c, na) || !mul_add(p, s.b, s.d, nb) ||
+                !mul_add(p, s.e, s.g, ne) || !mul_add(p, s.f, s.h, nf)) {
+                return false;
+            }
+            s.c = std::move(s.a); s.d = std::move(s.b);
+            s.g = std::move(s.e); s.h = std::move(s.f);
+            s.a = std::move(na); s.b = std::move(nb);
+            s.e = std::move(ne); s.f = std::move(nf);
+            return true;
+        }
+
+        /**
+         * @brief Подстановка y = q + 1/y':
+         * (a, b, c, d) → (a·q + b, a, c·q + d, c), аналогично для (e, f, g, h)
+         * @return false при переполнении (состояние не меняется)
+         */
+        template <typename T>
+        bool ingest_y_step(State<T>& s, const T& q) {
+            T na, nc, ne, ng;
+            if (!mul_add(q, s.a, s.b, na) || !mul_add(q, s.c, s.d, nc) ||
+                !mul_add(q, s.e, s.f, ne) || !mul_add(q, s.g, s.h, ng)) {
+                return false;
+            }
+            s.b = std::move(s.a); s.d = std::move(s.c);
+            s.f = std::move(s.e); s.h = std::move(s.g);
+            s.a = std::move(na); s.c = std::move(nc);
+            s.e = std::move(ne); s.g = std::move(ng);
+            return true;
+        }
+
+        /**
+         * @brief x → ∞: остаются только члены при x
+         */
+        template <typename T>
+        void exhaust_x_step(State<T>& s) {
+            s.c = std::move(s.a); s.d = std::move(s.b);
+            s.g = std::move(s.e); s.h = std::move(s.f);
+            s.a = T(0); s.b = T(0); s.e = T(0); s.f = T(0);
+        }
+
+        /**
+         * @brief y → ∞: остаются только члены при y
+         */
+        template <typename T>
+        void exhaust_y_step(State<T>& s) {
+            s.b = std::move(s.a); s.d = std::move(s.c);
+            s.f = std::move(s.e); s.h = std::move(s.g);
+            s.a = T(0); s.c = T(0); s.e = T(0); s.g = T(0);
+        }
+
+        /**
+         * @brief Поглощать ли x: разброс b/f относительно a/e отражает
+         *        неопределённость по y, разброс c/g - по x
+         */
+        template <typename T>
+        bool prefer_x_step(const State<T>& s, bool last_ingested_x) {
+            const double corner = corner_ratio(s.a, s.e);
+            const double spread_y = corner_spread(corner_ratio(s.b, s.f), corner);
+            const double spread_x = corner_spread(corner_ratio(s.c, s.g), corner);
+
+            if (spread_x == spread_y) {
+                return !last_ingested_x;
+            }
+            return spread_x > spread_y;
+        }
+
+        /**
+         * @brief Вывод settle() о хвосте остановившегося результата
+         */
+        enum class Settle {
+            Infinite,       ///< Знаменатели углов разного знака или нулевые: остаток ∞
+            Integer,        ///< Целые части углов - k - 1 и k: остаток k
+            Undetermined,   ///< Углы не указывают ни на ∞, ни на целое
+            Overflow        ///< Не хватает разрядности long long
+        };
+
+        /**
+         * @brief Классификация остановки по точным целым частям углов
+         *
+         * Углы лежат по обе стороны от значения остатка. Если за много шагов
+         * целые части не сошлись, остаток считается равным полюсу (знаменатели
+         * меняют знак) или целому k, к которому углы подходят с двух сторон.
+         */
+        template <typename T>
+        Settle settle_step(const State<T>& s, bool x_done, bool y_done, T& k) {
+            std::pair<const T*, const T*> corners[4];
+            const size_t count = live_corners(s, x_done, y_done, corners);
+
+            const int sign = sign_of(*corners[0].second);
+            for (size_t i = 0; i < count; ++i) {
+                if (sign == 0 || sign_of(*corners[i].second) != sign) {
+                    return Settle::Infinite;
+                }
+            }
+
+            T low, high;
+            if (!floor_quotient(*corners[0].first, *corners[0].second, low)) {
+                return Settle::Overflow;
+            }
+            high = low;
+            for (size_t i = 1; i < count; ++i) {
+                T q;
+                if (!floor_quotient(*corners[i].first, *corners[i].second, q)) {
+                    return Settle::Overflow;
+                }
+                if (q < low) {
+                    low = std::move(q);
+                } else if (high < q) {
+                    high = std::move(q);
+                }
+            }
+
+            T next = std::move(low);
+            next += T(1);
+            if (next != high) {
+                return Settle::Undetermined;
+            }
+            k = std::move(high);
+            return Settle::Integer;
+        }
+    }
+
+    // ==================== ИСТОЧНИКИ КОЭФФИЦИЕНТОВ ====================
+
+    /**
+     * @brief Источник коэффициентов для цепной дроби
+     *
+     * Коэффициенты копируются один раз и разделяются между копиями
+     * источника; позиция чтения у каждой копии своя.
+     */
+    TermSource make_term_source(const ContinuedFraction& cf) {
+        // Короткая дробь копируется вместе с коэффициентами одним выделением памяти
+        auto fraction = std::make_shared<const ContinuedFraction>(cf);
+        size_t index = 0;
+
+        return [fraction, index]() mutable -> std::optional<long long> {
+            const std::span<const long long> coeffs = fraction->coefficients();
+            if (index >= coeffs.size()) {
+                if (fraction->is_finite()) {
+                    return std::nullopt;
+                }
+                index = fraction->period_start();
+            }
+            return coeffs[index++];
+        };
+    }
+
+    // ==================== КОНСТРУКТОРЫ ====================
+
+    /**
+     * @brief Конструктор преобразования
+     */
+    BihomographicStream::BihomographicStream(TermSource x, TermSource y,
+                                             long long a, long long b, long long c, long long d,
+                                             long long e, long long f, long long g, long long h)
+        : x_(std::move(x))
+        , y_(std::move(y))
+        , small_{a, b, c, d, e, f, g, h}
+        , x_done_(false)
+        , y_done_(false)
+        , finished_(false)
+        , emitted_(false)
+        , last_ingested_x_(false)
+        , stalled_(0) {}
+    /**
+     * @brief x + y = (0·xy + 1·x + 1·y + 0) / (0·xy + 0·x + 0·y + 1)
+     */
+    BihomographicStream BihomographicStream::sum(TermSource x, TermSource y) {
+        return BihomographicStream(std::move(x), std::move(y), 0, 1, 1, 0, 0, 0, 0, 1);
+    }
+
+    /**
+     * @brief x - y = (0·xy + 1·x - 1·y + 0) / (0·xy + 0·x + 0·y + 1)
+     */
+    BihomographicStream BihomographicStream::difference(TermSource x, TermSource y) {
+        return BihomographicStream(std::move(x), std::move(y), 0, 1, -1, 0, 0, 0, 0, 1);
+    }
+
+    /**
+     * @brief x · y = (1·xy + 0·x + 0·y + 0) / (0·xy + 0·x + 0·y + 1)
+     */
+    BihomographicStream BihomographicStream::product(TermSource x, TermSource y) {
+        return BihomographicStream(std::move(x), std::move(y), 1, 0, 0, 0, 0, 0, 0, 1);
+    }
+
+    /**
+     * @brief x / y = (0·xy + 1·x + 0·y + 0) / (0·xy + 0·x + 1·y + 0)
+     */
+    BihomographicStream BihomographicStream::quotient(TermSource x, TermSource y) {
+        return BihomographicStream(std::move(x), std::move(y), 0, 1, 0, 0, 0, 0, 1, 0);
+    }
+
+    // ==================== ВЫДАЧА КОЭФФИЦИЕНТОВ ====================
+
+    /**
+     * @brief Получить следующий коэффициент результата
+     *
+     * Поглощает входные коэффициенты, пока очередной коэффициент
+     * результата не станет однозначным.
+     */
+    std::optional<long long> BihomographicStream::next() {
+        if (finished_) {
+            return std::nullopt;
+        }
+
+        while (true) {
+            long long term;
+            if (try_emit(term)) {
+                emitted_ = true;
+                stalled_ = 0;
+                return term;
+            }
+
+            if (x_done_ && y_done_) {
+                // Остаток d/h с h = 0 до первой выдачи - деление на ноль
+                const bool zero_denominator = big_ ? big_->h.is_zero() : small_.h == 0;
+                if (!emitted_ && zero_denominator) {
+                    throw std::domain_error("Деление на ноль");
+                }
+                finished_ = true;
+                return std::nullopt;
+            }
+
+            if (stalled_ >= MAX_STALLED_INGESTIONS) {
+                finished_ = true;
+                if (settle(term)) {
+                    return term;
+                }
+                return std::nullopt;
+            }
+
+            if (prefer_x()) {
+                ingest_x();
+            } else {
+                ingest_y();
+            }
+            ++stalled_;
+        }
+    }
+
+    /**
+     * @brief Собрать первые коэффициенты результата в цепную дробь
+     */
+    ContinuedFraction BihomographicStream::take(size_t max_terms) {
+        ContinuedFraction::Builder builder;
+        while (builder.size() < max_terms) {
+            std::optional<long long> term = next();
+            if (!term) {
+                break;
+            }
+            builder.push_back(*term);
+        }
+        return builder.finish();
+    }
+
+    // ==================== ВНУТРЕННИЕ ШАГИ АЛГОРИТМА ====================
+
+    /**
+     * @brief Проверка однозначности следующего коэффициента
+     *
+     * При переполнении long long состояние переводится в BigInt
+     * и проверка повторяется.
+     */
+    bool BihomographicStream::try_emit(long long& term) {
+        if (!big_) {
+            switch (emit_step(small_, x_done_, y_done_, term)) {
+                case Emit::Ready: return true;
+                case Emit::Pending: return false;
+                case Emit::Overflow: promote(); break;
+            }
+        }
+
+        BigInt q;
+        if (emit_step(*big_, x_done_, y_done_, q) != Emit::Ready) {
+            return false;
+        }
+        const std::optional<long long> value = q.to_int64();
+        if (!value) {
+            throw std::overflow_error("Коэффициент результата не помещается в long long");
+        }
+        term = *value;
+        return true;
+    }
+
+    /**
+     * @brief Поглощение коэффициента аргумента x
+     */
+    void BihomographicStream::ingest_x() {
+        last_ingested_x_ = true;
+        const std::optional<long long> p = x_();
+        if (!p) {
+            x_done_ = true;
+            if (big_) {
+                exhaust_x_step(*big_);
+            } else {
+                exhaust_x_step(small_);
+            }
+            return;
+        }
+
+        if (!big_ && ingest_x_step(small_, *p)) {
+            return;
+        }
+        if (!big_) {
+            promote();
+        }
+        ingest_x_step(*big_, BigInt(*p));
+    }
+
+    /**
+     * @brief Поглощение коэффициента аргумента y
+     */
+    void BihomographicStream::ingest_y() {
+        last_ingested_x_ = false;
+        const std::optional<long long> q = y_();
+        if (!q) {
+            y_done_ = true;
+            if (big_) {
+                exhaust_y_step(*big_);
+            } else {
+                exhaust_y_step(small_);
+            }
+            return;
+        }
+
+        if (!big_ && ingest_y_step(small_, *q)) {
+            return;
+        }
+        if (!big_) {
+            promote();
+        }
+        ingest_y_step(*big_, BigInt(*q));
+    }
+
+    /**
+     * @brief Выбор аргумента для поглощения
+     */
+    bool BihomographicStream::prefer_x() const {
+        if (x_done_) {
+            return false;
+        }
+        if (y_done_) {
+            return true;
+        }
+        return big_ ? prefer_x_step(*big_, last_ingested_x_)
+                    : prefer_x_step(small_, last_ingested_x_);
+    }
+
+    void BihomographicStream::promote() {
+        big_.emplace(State<BigInt>{small_.a, small_.b, small_.c, small_.d,
+                                   small_.e, small_.f, small_.g, small_.h});
+    }
+
+    /**
+     * @brief Завершение остановившегося результата
+     *
+     * Решение принимается по точному состоянию, но само по себе является
+     * допущением: остаток, отличающийся от ∞ или целого k меньше, чем
+     * позволяют различить MAX_STALLED_INGESTIONS шагов, будет принят за них.
+     */
+    bool BihomographicStream::settle(long long& term) {
+        Settle result = Settle::Overflow;
+        if (!big_) {
+            result = settle_step(small_, x_done_, y_done_, term);
+            if (result == Settle::Overflow) {
+                promote();
+            }
+        }
+
+        BigInt k;
+        if (result == Settle::Overflow) {
+            result = settle_step(*big_, x_done_, y_done_, k);
+            if (result == Settle::Integer) {
+                const std::optional<long long> value = k.to_int64();
+                if (!value) {
+                    throw std::overflow_error("Коэффициент результата не помещается в long long");
+                }
+                term = *value;
+            }
+        }
+
+        switch (result) {
+            case Settle::Integer:
+                return true;
+            case Settle::Infinite:
+                // Полюс до первой выдачи - само значение бесконечно
+                if (!emitted_) {
+                    throw std::domain_error("Деление на ноль");
+                }
+                return false;
+            default:
+                throw std::overflow_error("Коэффициент результата не определяется за конечное число шагов");
+        }
+    }
+}
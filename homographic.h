@@ -0,0 +1,187 @@
+/**
+ * @file homographic.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Потоковая арифметика цепных дробей по алгоритму Госпера
+ *
+ * Билинейно-дробное (бигомографическое) преобразование
+ *
+ *        a·x·y + b·x + c·y + d
+ *   z = -----------------------
+ *        e·x·y + f·x + g·y + h
+ *
+ * вычисляется непосредственно над коэффициентами x и y: входные
+ * коэффициенты потребляются по одному, а коэффициенты результата
+ * выдаются, как только они однозначно определены. Это позволяет
+ * выполнять точные арифметические операции без перехода к double
+ * и выстраивать цепочки операций, не раскрывая промежуточные дроби.
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef HOMOGRAPHIC_H
+#define HOMOGRAPHIC_H
+
+#include "continued_fraction.h"
+#include "big_integer.h"
+#include <cstddef>
+#include <functional>
+#include <optional>
+
+namespace Math {
+    /**
+     * @brief Источник коэффициентов цепной дроби
+     *
+     * Каждый вызов возвращает очередной коэффициент или std::nullopt,
+     * если дробь закончилась (конечная дробь).
+     */
+    using TermSource = std::function<std::optional<long long>()>;
+
+    /**
+     * @brief Создать источник коэффициентов для цепной дроби
+     * @param cf Цепная дробь (копируется в источник)
+     * @return Источник, выдающий коэффициенты cf; для периодической
+     *         дроби период повторяется бесконечно
+     */
+    TermSource make_term_source(const ContinuedFraction& cf);
+
+    /**
+     * @class BihomographicStream
+     * @brief Поток коэффициентов бигомографического преобразования двух дробей
+     *
+     * Предполагается, что входные дроби регулярные (aᵢ ≥ 1 при i ≥ 1).
+     * Состояние хранится в long long, а при переполнении переводится
+     * в BigInt, поэтому коэффициенты, выданные по совпадению целых частей
+     * углов, точны.
+     *
+     * Если результат рационален, а входы бесконечны (например, √2 - √2),
+     * очередной коэффициент может не определиться ни за какое число
+     * шагов. После MAX_STALLED_INGESTIONS шагов без выдачи поток
+     * завершает результат по точному состоянию: если знаменатели углов
+     * меняют знак, хвост считается равным ∞; если целые части углов равны
+     * k - 1 и k, последним выдается k; иначе бросается std::overflow_error.
+     * Это допущение, а не доказательство: значение, которое за эти шаги
+     * неотличимо от ∞ или целого k, будет принято за него.
+     *
+     * Сам поток является источником коэффициентов и может служить
+     * входом другого потока.
+     */
+    class BihomographicStream {
+    public:
+        /**
+         * @brief Наибольшее число поглощений подряд без выдачи коэффициента
+         */
+        static constexpr size_t MAX_STALLED_INGESTIONS = 256;
+
+        /**
+         * @brief Конструктор преобразования с произвольными коэффициентами
+         * @param x Источник коэффициентов первого аргумента
+         * @param y Источник коэффициентов второго аргумента
+         * @param a,b,c,d Коэффициенты числителя
+         * @param e,f,g,h Коэффициенты знаменателя
+         */
+        BihomographicStream(TermSource x, TermSource y,
+                            long long a, long long b, long long c, long long d,
+                            long long e, long long f, long long g, long long h);
+
+        /**
+         * @brief Поток для x + y
+         */
+        static BihomographicStream sum(TermSource x, TermSource y);
+
+        /**
+         * @brief Поток для x - y
+         */
+        static BihomographicStream difference(TermSource x, TermSource y);
+
+        /**
+         * @brief Поток для x · y
+         */
+        static BihomographicStream product(TermSource x, TermSource y);
+
+        /**
+         * @brief Поток для x / y
+         */
+        static BihomographicStream quotient(TermSource x, TermSource y);
+
+        /**
+         * @brief Получить следующий коэффициент результата
+         * @return Коэффициент или std::nullopt, если результат исчерпан
+         * @throw std::overflow_error Если коэффициент не помещается в long long
+         *        или не определяется (см. описание класса)
+         * @throw std::domain_error При делении на ноль, в том числе если
+         *        значение остановилось на ∞ до первой выдачи
+         */
+        std::optional<long long> next();
+
+        /**
+         * @brief Синоним next() для использования в качестве TermSource
+         */
+        std::optional<long long> operator()() { return next(); }
+
+        /**
+         * @brief Собрать не более max_terms коэффициентов в цепную дробь
+         * @param max_terms Максимальное количество коэффициентов
+         * @return Цепная дробь (конечная)
+         */
+        ContinuedFraction take(size_t max_terms);
+
+        /**
+         * @brief Коэффициенты преобразования (a, b, c, d, e, f, g, h)
+         */
+        template <typename T>
+        struct State {
+            T a, b, c, d;   ///< Коэффициенты числителя
+            T e, f, g, h;   ///< Коэффициенты знаменателя
+        };
+
+    private:
+        /**
+         * @brief Попытаться выдать коэффициент результата
+         * @param term Выданный коэффициент
+         * @return true, если коэффициент однозначно определён
+         */
+        bool try_emit(long long& term);
+
+        /**
+         * @brief Поглотить очередной коэффициент x
+         */
+        void ingest_x();
+
+        /**
+         * @brief Поглотить очередной коэффициент y
+         */
+        void ingest_y();
+
+        /**
+         * @brief Выбрать аргумент для поглощения
+         * @return true - поглощать x, false - поглощать y
+         */
+        bool prefer_x() const;
+
+        /**
+         * @brief Перевести состояние в BigInt
+         */
+        void promote();
+
+        /**
+         * @brief Завершить результат, остановившийся на рациональном значении
+         * @param term Последний коэффициент, если хвост - целое число
+         * @return true, если term нужно выдать
+         */
+        bool settle(long long& term);
+
+        TermSource x_;                      ///< Источник первого аргумента
+        TermSource y_;                      ///< Источник второго аргумента
+        State<long long> small_;            ///< Состояние, пока оно помещается в long long
+        std::optional<State<BigInt>> big_;  ///< Состояние после переполнения
+        bool x_done_;                       ///< Первый аргумент исчерпан
+        bool y_done_;                       ///< Второй аргумент исчерпан
+        bool finished_;                     ///< Результат исчерпан
+        bool emitted_;                      ///< Выдан хотя бы один коэффициент
+        bool last_ingested_x_;              ///< Последним поглощался x
+        size_t stalled_;                    ///< Поглощений после последней выдачи
+    };
+}
+
+#endif // HOMOGRAPHIC_H
@@ -0,0 +1,267 @@
+/**
+ * @file instrumentation.cpp
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Хранение и сбор метрик по потокам
+ *
+ * Лицензия: MIT
+ */
+
+#include "instrumentation.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+namespace Math {
+    namespace instrumentation {
+        namespace {
+            /**
+             * @brief Увеличение значения, которое пишет только один поток
+             *
+             * Чтение и запись по отдельности атомарны, поэтому другие
+             * потоки видят целое значение, а сам шаг обходится без
+             * блокирующей инструкции fetch_add.
+             */
+            void bump(std::atomic<std::uint64_t>& value, std::uint64_t amount) noexcept {
+                value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+            }
+
+            /**
+             * @brief Гистограмма одного потока
+             *
+             * Пишет только поток-владелец; атомарность нужна для чтения
+             * из snapshot() и сброса из reset() в других потоках.
+             */
+            struct AtomicHistogram {
+                std::array<std::atomic<std::uint64_t>, Histogram::BUCKETS> buckets{};
+                std::atomic<std::uint64_t> count{0};
+                std::atomic<std::uint64_t> sum{0};
+                std::atomic<std::uint64_t> max{0};
+
+                void record(std::uint64_t value) noexcept {
+                    bump(buckets[Histogram::bucket_index(value)], 1);
+                    bump(count, 1);
+                    bump(sum, value);
+                    if (value > max.load(std::memory_order_relaxed)) {
+                        max.store(value, std::memory_order_relaxed);
+                    }
+                }
+
+                Histogram load() const noexcept {
+                    Histogram result;
+                    for (size_t i = 0; i < Histogram::BUCKETS; ++i) {
+                        result.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+                    }
+                    result.count = count.load(std::memory_order_relaxed);
+                    result.sum = sum.load(std::memory_order_relaxed);
+                    result.max = max.load(std::memory_order_relaxed);
+                    return result;
+                }
+
+                void clear() noexcept {
+                    for (auto& bucket : buckets) {
+                        bucket.store(0, std::memory_order_relaxed);
+                    }
+                    count.store(0, std::memory_order_relaxed);
+                    sum.store(0, std::memory_order_relaxed);
+                    max.store(0, std::memory_order_relaxed);
+                }
+            };
+
+            /**
+             * @brief Метрики одного потока
+             */
+            struct ThreadMetrics {
+                std::array<std::atomic<std::uint64_t>, COUNTER_COUNT> counters{};
+                std::array<AtomicHistogram, TIMER_COUNT> timings;
+                AtomicHistogram coefficient_counts;
+
+                Snapshot load() const noexcept {
+                    Snapshot result;
+                    for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+                        result.counters[i] = counters[i].load(std::memory_order_relaxed);
+                    }
+                    for (size_t i = 0; i < TIMER_COUNT; ++i) {
+                        result.timings[i] = timings[i].load();
+                    }
+                    result.coefficient_counts = coefficient_counts.load();
+                    result.threads = 1;
+                    return result;
+                }
+
+                void clear() noexcept {
+                    for (auto& counter : counters) {
+                        counter.store(0, std::memory_order_relaxed);
+                    }
+                    for (auto& timing : timings) {
+                        timing.clear();
+                    }
+                    coefficient_counts.clear();
+                }
+            };
+
+            /**
+             * @brief Метрики работающих потоков и сумма завершившихся
+             */
+            struct Registry {
+                std::mutex mutex;
+                std::vector<ThreadMetrics*> threads;   ///< Метрики работающих потоков
+                Snapshot retired;                      ///< Сумма метрик завершившихся потоков
+            };
+
+            /**
+             * @brief Общий реестр
+             *
+             * Не разрушается: потоки могут завершаться после выхода из main().
+             */
+            Registry& registry() {
+                static Registry* instance = new Registry();
+                return *instance;
+            }
+
+            /**
+             * @brief Регистрация метрик потока на время его жизни
+             */
+            struct ThreadSlot {
+                ThreadMetrics metrics;
+
+                ThreadSlot() {
+                    Registry& reg = registry();
+                    std::lock_guard<std::mutex> lock(reg.mutex);
+                    reg.threads.push_back(&metrics);
+                }
+
+                ~ThreadSlot() {
+                    Registry& reg = registry();
+                    std::lock_guard<std::mutex> lock(reg.mutex);
+                    reg.retired += metrics.load();
+                    reg.threads.erase(std::find(reg.threads.begin(), reg.threads.end(), &metrics));
+                }
+
+                ThreadSlot(const ThreadSlot&) = delete;
+                ThreadSlot& operator=(const ThreadSlot&) = delete;
+            };
+
+            ThreadMetrics& local_metrics() {
+                thread_local ThreadSlot slot;
+                return slot.metrics;
+            }
+        }
+
+        // ==================== ИМЕНА МЕТРИК ====================
+
+        const char* name(Counter counter) noexcept {
+            switch (counter) {
+                case Counter::Normalize: return "normalize";
+                case Counter::CacheInvalidation: return "cache_invalidation";
+                case Counter::ConvergentExtension: return "convergent_extension";
+                case Counter::ConvergentTerm: return "convergent_term";
+                case Counter::ToDoubleCall: return "to_double_call";
+                case Counter::ToDoubleMiss: return "to_double_miss";
+                case Counter::COUNT: break;
+            }
+            return "unknown";
+        }
+
+        const char* name(Timer timer) noexcept {
+            switch (timer) {
+                case Timer::Normalize: return "normalize";
+                case Timer::ConvergentExtension: return "convergent_extension";
+                case Timer::ToDoubleMiss: return "to_double_miss";
+                case Timer::COUNT: break;
+            }
+            return "unknown";
+        }
+
+        // ==================== АГРЕГИРОВАНИЕ ====================
+
+        /**
+         * @brief Наибольшее значение корзины, в которую попадает квантиль
+         */
+        std::uint64_t Histogram::quantile(double q) const noexcept {
+            if (count == 0) {
+                return 0;
+            }
+
+            const double clamped = std::clamp(q, 0.0, 1.0);
+            const std::uint64_t rank = std::max<std::uint64_t>(
+                1, static_cast<std::uint64_t>(std::ceil(clamped * static_cast<double>(count))));
+            std::uint64_t seen = 0;
+            for (size_t i = 0; i < BUCKETS; ++i) {
+                seen += buckets[i];
+                if (seen >= rank) {
+                    return i == 0 ? 0 : std::min(bucket_limit(i) - 1, max);
+                }
+            }
+            return max;
+        }
+
+        Histogram& Histogram::operator+=(const Histogram& other) noexcept {
+            for (size_t i = 0; i < BUCKETS; ++i) {
+                buckets[i] += other.buckets[i];
+            }
+            count += other.count;
+            sum += other.sum;
+            max = std::max(max, other.max);
+            return *this;
+        }
+
+        Snapshot& Snapshot::operator+=(const Snapshot& other) noexcept {
+            for (size_t i = 0; i < COUNTER_COUNT; ++i) {
+                counters[i] += other.counters[i];
+            }
+            for (size_t i = 0; i < TIMER_COUNT; ++i) {
+                timings[i] += other.timings[i];
+            }
+            coefficient_counts += other.coefficient_counts;
+            threads += other.threads;
+            return *this;
+        }
+
+        // ==================== СНИМКИ ====================
+
+        Snapshot snapshot() {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            Snapshot result = reg.retired;
+            for (const ThreadMetrics* metrics : reg.threads) {
+                result += metrics->load();
+            }
+            return result;
+        }
+
+        Snapshot thread_snapshot() {
+            if constexpr (!enabled) {
+                return Snapshot();
+            }
+            return local_metrics().load();
+        }
+
+        void reset() {
+            Registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            reg.retired = Snapshot();
+            for (ThreadMetrics* metrics : reg.threads) {
+                metrics->clear();
+            }
+        }
+
+        // ==================== ЗАПИСЬ ====================
+
+        namespace detail {
+            void add(Counter counter, std::uint64_t amount) noexcept {
+                bump(local_metrics().counters[static_cast<size_t>(counter)], amount);
+            }
+
+            void record_duration(Timer timer, std::uint64_t nanoseconds) noexcept {
+                local_metrics().timings[static_cast<size_t>(timer)].record(nanoseconds);
+            }
+
+            void record_coefficient_count(size_t count) noexcept {
+                local_metrics().coefficient_counts.record(count);
+            }
+        }
+    }
+}
@@ -0,0 +1,216 @@
+/**
+ * @file instrumentation.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Счетчики и гистограммы горячих путей библиотеки
+ *
+ * Включается на этапе сборки определением
+ * CONTINUED_FRACTION_INSTRUMENTATION (CMake-опция с тем же именем).
+ * Без него макросы CF_INSTRUMENT_* раскрываются в пустые выражения,
+ * а snapshot() возвращает нули.
+ *
+ * Каждый поток пишет в собственный набор счетчиков без блокировок;
+ * snapshot() суммирует наборы всех потоков, включая завершившиеся:
+ *
+ *   const auto stats = Math::instrumentation::snapshot();
+ *   stats.counter(Math::instrumentation::Counter::ToDoubleMiss);
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Math {
+    namespace instrumentation {
+        /**
+         * @brief Включена ли инструментация в этой сборке
+         */
+#if defined(CONTINUED_FRACTION_INSTRUMENTATION)
+        inline constexpr bool enabled = true;
+#else
+        inline constexpr bool enabled = false;
+#endif
+
+        /**
+         * @brief Счетчики событий
+         */
+        enum class Counter : size_t {
+            Normalize,            ///< Проходы нормализации коэффициентов
+            CacheInvalidation,    ///< Сбросы кэшей значения и подходящих дробей
+            ConvergentExtension,  ///< Дополнения кэша подходящих дробей
+            ConvergentTerm,       ///< Вычисленные подходящие дроби
+            ToDoubleCall,         ///< Вызовы to_double()
+            ToDoubleMiss,         ///< Вызовы to_double() без готового значения
+            COUNT
+        };
+
+        /**
+         * @brief Операции, время которых измеряется
+         */
+        enum class Timer : size_t {
+            Normalize,            ///< normalize() и нормализация хвоста
+            ConvergentExtension,  ///< Дополнение кэша подходящих дробей
+            ToDoubleMiss,         ///< Вычисление значения в to_double()
+            COUNT
+        };
+
+        inline constexpr size_t COUNTER_COUNT = static_cast<size_t>(Counter::COUNT);
+        inline constexpr size_t TIMER_COUNT = static_cast<size_t>(Timer::COUNT);
+
+        /**
+         * @brief Имя счетчика для экспорта метрик ("normalize", ...)
+         */
+        const char* name(Counter counter) noexcept;
+
+        /**
+         * @brief Имя измеряемой операции для экспорта метрик
+         */
+        const char* name(Timer timer) noexcept;
+
+        /**
+         * @struct Histogram
+         * @brief Гистограмма с логарифмическими корзинами
+         *
+         * Корзина 0 содержит значение 0, корзина i ≥ 1 - значения
+         * [2ⁱ⁻¹, 2ⁱ).
+         */
+        struct Histogram {
+            static constexpr size_t BUCKETS = 65;
+
+            std::array<std::uint64_t, BUCKETS> buckets{};   ///< Число значений в корзинах
+            std::uint64_t count = 0;                        ///< Число значений
+            std::uint64_t sum = 0;                          ///< Сумма значений
+            std::uint64_t max = 0;                          ///< Наибольшее значение
+
+            /**
+             * @brief Индекс корзины для значения
+             */
+            static constexpr size_t bucket_index(std::uint64_t value) noexcept {
+                size_t index = 0;
+                while (value != 0) {
+                    value >>= 1;
+                    ++index;
+                }
+                return index;
+            }
+
+            /**
+             * @brief Верхняя граница (исключительно) корзины index
+             */
+            static constexpr std::uint64_t bucket_limit(size_t index) noexcept {
+                return index >= 64 ? UINT64_MAX : std::uint64_t{1} << index;
+            }
+
+            double mean() const noexcept {
+                return count == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(count);
+            }
+
+            /**
+             * @brief Оценка сверху для квантиля q ∈ [0, 1]
+             * @return Верхняя граница корзины, содержащей квантиль (не больше max)
+             */
+            std::uint64_t quantile(double q) const noexcept;
+
+            Histogram& operator+=(const Histogram& other) noexcept;
+        };
+
+        /**
+         * @struct Snapshot
+         * @brief Согласованные по каждому потоку значения всех метрик
+         */
+        struct Snapshot {
+            std::array<std::uint64_t, COUNTER_COUNT> counters{};   ///< Значения счетчиков
+            std::array<Histogram, TIMER_COUNT> timings;            ///< Длительности, нс
+            Histogram coefficient_counts;   ///< Длины дробей после нормализации
+            size_t threads = 0;             ///< Число потоков, записавших метрики
+
+            std::uint64_t counter(Counter c) const noexcept {
+                return counters[static_cast<size_t>(c)];
+            }
+
+            const Histogram& timing(Timer t) const noexcept {
+                return timings[static_cast<size_t>(t)];
+            }
+
+            Snapshot& operator+=(const Snapshot& other) noexcept;
+        };
+
+        /**
+         * @brief Сумма метрик всех потоков с момента запуска или reset()
+         */
+        Snapshot snapshot();
+
+        /**
+         * @brief Метрики вызывающего потока
+         */
+        Snapshot thread_snapshot();
+
+        /**
+         * @brief Обнулить метрики всех потоков
+         *
+         * Счетчики пишутся без атомарного приращения, поэтому запись,
+         * совпавшая со сбросом, может вернуть счетчику прежнее значение.
+         */
+        void reset();
+
+        namespace detail {
+            void add(Counter counter, std::uint64_t amount) noexcept;
+            void record_duration(Timer timer, std::uint64_t nanoseconds) noexcept;
+            void record_coefficient_count(size_t count) noexcept;
+
+            /**
+             * @brief Измерение длительности области видимости
+             */
+            class ScopedTimer {
+            public:
+                explicit ScopedTimer(Timer timer) noexcept
+                    : timer_(timer), start_(std::chrono::steady_clock::now()) {}
+
+                ~ScopedTimer() {
+                    const auto elapsed = std::chrono::steady_clock::now() - start_;
+                    record_duration(timer_, static_cast<std::uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+                }
+
+                ScopedTimer(const ScopedTimer&) = delete;
+                ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+            private:
+                Timer timer_;
+                std::chrono::steady_clock::time_point start_;
+            };
+        }
+    }
+}
+
+#define CF_INSTRUMENT_CONCAT_IMPL(a, b) a##b
+#define CF_INSTRUMENT_CONCAT(a, b) CF_INSTRUMENT_CONCAT_IMPL(a, b)
+
+#if defined(CONTINUED_FRACTION_INSTRUMENTATION)
+/// Увеличить счетчик Counter::name на amount
+#define CF_INSTRUMENT_ADD(name, amount) \
+    ::Math::instrumentation::detail::add(::Math::instrumentation::Counter::name, \
+                                         static_cast<std::uint64_t>(amount))
+/// Увеличить счетчик Counter::name на 1
+#define CF_INSTRUMENT_COUNT(name) CF_INSTRUMENT_ADD(name, 1)
+/// Измерить время до конца текущей области видимости
+#define CF_INSTRUMENT_TIMER(name) \
+    const ::Math::instrumentation::detail::ScopedTimer CF_INSTRUMENT_CONCAT(cf_timer_, __LINE__)( \
+        ::Math::instrumentation::Timer::name)
+/// Записать длину дроби в гистограмму coefficient_counts
+#define CF_INSTRUMENT_COEFFICIENTS(count) \
+    ::Math::instrumentation::detail::record_coefficient_count(count)
+#else
+#define CF_INSTRUMENT_ADD(name, amount) static_cast<void>(0)
+#define CF_INSTRUMENT_COUNT(name) static_cast<void>(0)
+#define CF_INSTRUMENT_TIMER(name) static_cast<void>(0)
+#define CF_INSTRUMENT_COEFFICIENTS(count) static_cast<void>(0)
+#endif
+
+#endif // INSTRUMENTATION_H
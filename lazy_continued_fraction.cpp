@@ -0,0 +1,239 @@
+/**
+ * @file lazy_continued_fraction.cpp
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Реализация ленивых цепных дробей и генераторов констант
+ */
+
+#include "lazy_continued_fraction.h"
+#include "checked_arithmetic.h"
+#include "pi_expansion.h"
+#include "sqrt_expansion.h"
+#include "static_continued_fraction.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace Math {
+    // ==================== КОНСТРУКТОРЫ ====================
+
+    /**
+     * @brief Конструктор из источника коэффициентов
+     */
+    LazyContinuedFraction::LazyContinuedFraction(TermSource source, size_t buffer_limit)
+        : state_(std::make_shared<State>(State{std::move(source), {}, {}, buffer_limit, false})) {}
+
+    /**
+     * @brief Конструктор из обычной цепной дроби
+     */
+    LazyContinuedFraction::LazyContinuedFraction(const ContinuedFraction& cf)
+        : LazyContinuedFraction(make_term_source(cf)) {}
+
+    // ==================== ДОСТУП К КОЭФФИЦИЕНТАМ ====================
+
+    /**
+     * @brief Вычисление коэффициентов до индекса i
+     * @throw std::length_error при выходе за предел буфера
+     */
+    bool LazyContinuedFraction::fill_to(size_t i) const {
+        State& state = *state_;
+        while (state.buffer.size() <= i) {
+            if (state.exhausted) {
+                return false;
+            }
+            if (state.buffer.size() >= state.buffer_limit) {
+                throw std::length_error("Превышен предел буфера ленивой цепной дроби");
+            }
+
+            std::optional<long long> term = state.source();
+            if (!term) {
+                state.exhausted = true;
+                return false;
+            }
+            state.buffer.push_back(*term);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Получить коэффициент с индексом i
+     */
+    std::optional<long long> LazyContinuedFraction::coefficient(size_t i) const {
+        if (!fill_to(i)) {
+            return std::nullopt;
+        }
+        return state_->buffer[i];
+    }
+
+    /**
+     * @brief Количество вычисленных коэффициентов
+     */
+    size_t LazyContinuedFraction::computed_terms() const {
+        return state_->buffer.size();
+    }
+
+    /**
+     * @brief Получить n-ю подходящую дробь
+     *
+     * Рекуррентные формулы те же, что и в ContinuedFraction,
+     * но с контролем переполнения. Вычисленные дроби запоминаются,
+     * поэтому последовательные вызовы продолжают рекурсию.
+     */
+    std::pair<long long, long long> LazyContinuedFraction::convergent(size_t n) const {
+        if (!fill_to(n)) {
+            throw std::out_of_range("Индекс подходящей дроби вне диапазона");
+        }
+
+        const std::vector<long long>& coeffs = state_->buffer;
+        std::vector<std::pair<long long, long long>>& convergents = state_->convergents;
+        if (convergents.empty()) {
+            convergents.emplace_back(coeffs[0], 1);
+        }
+
+        for (size_t i = convergents.size(); i <= n; ++i) {
+            const auto [prev_num, prev_den] = i >= 2 ? convergents[i - 2]
+                                                     : std::pair<long long, long long>{1, 0};
+            const auto [curr_num, curr_den] = convergents[i - 1];
+            const long long new_num = detail::mul_add_or_throw(coeffs[i], curr_num, prev_num);
+            const long long new_den = detail::mul_add_or_throw(coeffs[i], curr_den, prev_den);
+            convergents.emplace_back(new_num, new_den);
+        }
+
+        return convergents[n];
+    }
+
+    /**
+     * @brief Значение с заданной точностью
+     *
+     * Подходящие дроби вычисляются в double: |pₖ/qₖ - pₖ₋₁/qₖ₋₁| = 1/(qₖ·qₖ₋₁),
+     * поэтому остановка происходит, как только эта величина меньше tolerance.
+     */
+    double LazyContinuedFraction::to_double(double tolerance, size_t max_terms) const {
+        if (!fill_to(0)) {
+            return 0.0;
+        }
+
+        double prev_num = 1.0;
+        double prev_den = 0.0;
+        double curr_num = static_cast<double>(state_->buffer[0]);
+        double curr_den = 1.0;
+
+        for (size_t i = 1; i < max_terms && fill_to(i); ++i) {
+            const double coeff = static_cast<double>(state_->buffer[i]);
+            const double new_num = coeff * curr_num + prev_num;
+            const double new_den = coeff * curr_den + prev_den;
+            prev_num = curr_num;
+            prev_den = curr_den;
+            curr_num = new_num;
+            curr_den = new_den;
+
+            if (std::abs(1.0 / (curr_den * prev_den)) < tolerance) {
+                break;
+            }
+        }
+
+        return curr_num / curr_den;
+    }
+
+    /**
+     * @brief Материализация первых коэффициентов
+     */
+    ContinuedFraction LazyContinuedFraction::take(size_t max_terms) const {
+        if (max_terms == 0 || !fill_to(0)) {
+            return ContinuedFraction();
+        }
+
+        const size_t count = fill_to(max_terms - 1) ? max_terms : state_->buffer.size();
+        ContinuedFraction::Builder builder(count);
+        builder.append(std::span<const long long>(state_->buffer).first(count));
+        return builder.finish();
+    }
+
+    /**
+     * @brief Источник коэффициентов поверх общего буфера
+     */
+    TermSource LazyContinuedFraction::terms() const {
+        LazyContinuedFraction self = *this;
+        size_t index = 0;
+        return [self, index]() mutable {
+            return self.coefficient(index++);
+        };
+    }
+
+    // ==================== ЛЕНИВАЯ АРИФМЕТИКА ====================
+
+    LazyContinuedFraction operator+(const LazyContinuedFraction& x, const LazyContinuedFraction& y) {
+        return LazyContinuedFraction(BihomographicStream::sum(x.terms(), y.terms()));
+    }
+
+    LazyContinuedFraction operator-(const LazyContinuedFraction& x, const LazyContinuedFraction& y) {
+        return LazyContinuedFraction(BihomographicStream::difference(x.terms(), y.terms()));
+    }
+
+    LazyContinuedFraction operator*(const LazyContinuedFraction& x, const LazyContinuedFraction& y) {
+        return LazyContinuedFraction(BihomographicStream::product(x.terms(), y.terms()));
+    }
+
+    LazyContinuedFraction operator/(const LazyContinuedFraction& x, const LazyContinuedFraction& y) {
+        return LazyContinuedFraction(BihomographicStream::quotient(x.terms(), y.terms()));
+    }
+
+    // ==================== ЛЕНИВЫЕ КОНСТАНТЫ ====================
+
+    /**
+     * @brief Ленивая дробь для √n
+     *
+     * Тот же алгоритм, что и в sqrt_continued_fraction, но без
+     * остановки: рекуррентность сама повторяет период.
+     */
+    LazyContinuedFraction lazy_sqrt_continued_fraction(long long n) {
+        if (n < 0) {
+            throw std::invalid_argument("Нельзя вычислить корень из отрицательного числа");
+        }
+
+        detail::SqrtTermGenerator terms(n);
+        if (terms.is_perfect_square()) {
+            return LazyContinuedFraction(ContinuedFraction(terms.a0()));
+        }
+
+        bool first = true;
+        return LazyContinuedFraction([terms, first]() mutable -> std::optional<long long> {
+            if (first) {
+                first = false;
+                return terms.a0();
+            }
+            return terms.next();
+        });
+    }
+
+    /**
+     * @brief Ленивая дробь для e = [2; 1, 2, 1, 1, 4, 1, 1, 6, ...]
+     */
+    LazyContinuedFraction lazy_e_continued_fraction() {
+        size_t i = 0;
+        return LazyContinuedFraction([i]() mutable -> std::optional<long long> {
+            return detail::e_term(i++);
+        });
+    }
+
+    namespace {
+        constexpr size_t PI_INITIAL_TERMS = 64;   ///< Размер первого блока коэффициентов π
+    }
+
+    /**
+     * @brief Ленивая дробь для π
+     *
+     * Коэффициенты вычисляются блоками через detail::pi_terms; когда
+     * блок исчерпан, точность удваивается и блок вычисляется заново.
+     */
+    LazyContinuedFraction lazy_pi_continued_fraction() {
+        std::vector<long long> terms;
+        size_t next = 0;
+        return LazyContinuedFraction([terms, next]() mutable -> std::optional<long long> {
+            if (next == terms.size()) {
+                terms = detail::pi_terms(std::max(PI_INITIAL_TERMS, 2 * terms.size()));
+            }
+            return terms[next++];
+        });
+    }
+}
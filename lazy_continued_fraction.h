@@ -0,0 +1,173 @@
+/**
+ * @file lazy_continued_fraction.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Ленивые цепные дроби с вычислением коэффициентов по требованию
+ *
+ * LazyContinuedFraction оборачивает источник коэффициентов (TermSource)
+ * и запрашивает у него коэффициенты только тогда, когда они нужны.
+ * Полученные коэффициенты запоминаются в буфере ограниченного размера,
+ * поэтому повторное обращение к ним не требует повторных вычислений.
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef LAZY_CONTINUED_FRACTION_H
+#define LAZY_CONTINUED_FRACTION_H
+
+#include "continued_fraction.h"
+#include "homographic.h"
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace Math {
+    /**
+     * @class LazyContinuedFraction
+     * @brief Цепная дробь, коэффициенты которой вычисляются лениво
+     *
+     * Копии объекта разделяют общий буфер коэффициентов.
+     * Класс не является потокобезопасным.
+     */
+    class LazyContinuedFraction {
+    public:
+        /**
+         * @brief Размер буфера коэффициентов по умолчанию
+         */
+        static constexpr size_t DEFAULT_BUFFER_LIMIT = 1 << 16;
+
+        /**
+         * @brief Конструктор из источника коэффициентов
+         * @param source Источник коэффициентов
+         * @param buffer_limit Максимальное количество запоминаемых коэффициентов
+         */
+        explicit LazyContinuedFraction(TermSource source,
+                                       size_t buffer_limit = DEFAULT_BUFFER_LIMIT);
+
+        /**
+         * @brief Конструктор из обычной цепной дроби
+         * @param cf Цепная дробь (периодическая повторяет период бесконечно)
+         */
+        explicit LazyContinuedFraction(const ContinuedFraction& cf);
+
+        /**
+         * @brief Получить коэффициент с индексом i
+         * @param i Индекс коэффициента
+         * @return Коэффициент или std::nullopt, если дробь короче
+         * @throw std::length_error При выходе за предел буфера
+         */
+        std::optional<long long> coefficient(size_t i) const;
+
+        /**
+         * @brief Количество уже вычисленных коэффициентов
+         */
+        size_t computed_terms() const;
+
+        /**
+         * @brief Получить n-ю подходящую дробь
+         * @param n Индекс подходящей дроби (0-based)
+         * @return Пара {числитель, знаменатель}
+         * @throw std::out_of_range Если дробь конечна и короче n + 1
+         * @throw std::overflow_error При переполнении long long
+         */
+        std::pair<long long, long long> convergent(size_t n) const;
+
+        /**
+         * @brief Вычислить значение с заданной точностью
+         *
+         * Читает подходящие дроби, пока разность соседних не станет
+         * меньше tolerance (или пока не закончатся коэффициенты).
+         *
+         * @param tolerance Требуемая абсолютная точность
+         * @param max_terms Максимальное количество читаемых коэффициентов
+         * @return Приближенное значение
+         */
+        double to_double(double tolerance = 1e-15, size_t max_terms = 64) const;
+
+        /**
+         * @brief Материализовать первые max_terms коэффициентов
+         * @param max_terms Максимальное количество коэффициентов
+         * @return Конечная цепная дробь
+         */
+        ContinuedFraction take(size_t max_terms) const;
+
+        /**
+         * @brief Источник коэффициентов, читающий дробь с начала
+         *
+         * Источник использует общий буфер, поэтому коэффициенты
+         * не вычисляются повторно.
+         */
+        TermSource terms() const;
+
+    private:
+        /**
+         * @struct State
+         * @brief Разделяемое состояние: источник, буфер коэффициентов
+         *        и вычисленные подходящие дроби
+         */
+        struct State {
+            TermSource source;               ///< Источник коэффициентов
+            std::vector<long long> buffer;   ///< Уже вычисленные коэффициенты
+            std::vector<std::pair<long long, long long>> convergents;   ///< Вычисленные подходящие дроби
+            size_t buffer_limit;             ///< Предел размера буфера
+            bool exhausted;                  ///< Источник исчерпан
+        };
+
+        /**
+         * @brief Вычислить коэффициенты до индекса i включительно
+         * @return true, если коэффициент с индексом i существует
+         */
+        bool fill_to(size_t i) const;
+
+        std::shared_ptr<State> state_;       ///< Разделяемое состояние
+    };
+
+    // ==================== ЛЕНИВАЯ АРИФМЕТИКА ====================
+
+    /**
+     * @brief Ленивое сложение (алгоритм Госпера)
+     */
+    LazyContinuedFraction operator+(const LazyContinuedFraction& x, const LazyContinuedFraction& y);
+
+    /**
+     * @brief Ленивое вычитание (алгоритм Госпера)
+     */
+    LazyContinuedFraction operator-(const LazyContinuedFraction& x, const LazyContinuedFraction& y);
+
+    /**
+     * @brief Ленивое умножение (алгоритм Госпера)
+     */
+    LazyContinuedFraction operator*(const LazyContinuedFraction& x, const LazyContinuedFraction& y);
+
+    /**
+     * @brief Ленивое деление (алгоритм Госпера)
+     */
+    LazyContinuedFraction operator/(const LazyContinuedFraction& x, const LazyContinuedFraction& y);
+
+    // ==================== ЛЕНИВЫЕ КОНСТАНТЫ ====================
+
+    /**
+     * @brief Ленивая цепная дробь для √n
+     * @param n Число под корнем
+     * @return Бесконечная (или для полного квадрата - целая) дробь
+     * @throw std::invalid_argument При отрицательном n
+     */
+    LazyContinuedFraction lazy_sqrt_continued_fraction(long long n);
+
+    /**
+     * @brief Ленивая цепная дробь для числа e
+     * @return Бесконечная дробь [2; 1, 2, 1, 1, 4, 1, 1, 6, ...]
+     */
+    LazyContinuedFraction lazy_e_continued_fraction();
+
+    /**
+     * @brief Ленивая цепная дробь для числа π
+     * @return Бесконечная дробь [3; 7, 15, 1, 292, ...]; её начало
+     *         совпадает с pi_continued_fraction()
+     */
+    LazyContinuedFraction lazy_pi_continued_fraction();
+}
+
+#endif // LAZY_CONTINUED_FRACTION_H
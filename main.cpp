@@ -13,10 +13,13 @@
  */
 
 #include "continued_fraction.h"
+#include "continued_fraction_io.h"
 #include <iostream>
 #include <iomanip>
 #include <vector>
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 using namespace Math;
 
@@ -109,14 +112,15 @@ void example_convergents() {
               << std::setw(15) << "Знаменатель"
               << std::setw(20) << "Значение" << std::endl;
 
-    for (size_t i = 0; i < cf.size(); ++i) {
-        auto [num, den] = cf.convergent(i);
+    size_t i = 0;
+    for (auto [num, den] : cf.convergents(0, cf.size())) {
         double value = static_cast<double>(num) / den;
 
         std::cout << std::setw(5) << i
                   << std::setw(15) << num
                   << std::setw(15) << den
                   << std::setw(20) << std::setprecision(10) << value << std::endl;
+        ++i;
     }
 }
 
@@ -195,11 +199,13 @@ void example_comparison() {
  * @brief Главная функция программы
  */
 int main() {
+#ifdef _WIN32
     //UTF-8
     SetConsoleOutputCP(CP_UTF8);
     SetConsoleCP(CP_UTF8);
     // locale::global(locale(""));
     SetConsoleOutputCP(CP_UTF8);
+#endif
     std::cout << "ДЕМОНСТРАЦИЯ БИБЛИОТЕКИ ЦЕПНЫХ ДРОБЕЙ\n";
     std::cout << "======================================\n";
 
@@ -0,0 +1,122 @@
+/**
+ * @file matrix_product.cpp
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Реализация дерева произведений матриц коэффициентов
+ */
+
+#include "matrix_product.h"
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace Math {
+    namespace {
+        constexpr size_t LEAF_TERMS = 16;              ///< Коэффициентов в листе дерева
+        constexpr size_t PARALLEL_MIN_TERMS = 4096;    ///< Меньшие поддеревья не делятся между потоками
+
+        /**
+         * @brief Лист дерева: последовательное домножение справа на M(t)
+         *
+         * [[a, b], [c, d]]·[[t, 1], [1, 0]] = [[a·t + b, a], [c·t + d, c]];
+         * значения в листе малы, и BigInt считает их без выделения памяти.
+         */
+        BigMatrix leaf_product(std::span<const long long> terms) {
+            BigMatrix m;
+            for (long long t : terms) {
+                const BigInt coeff = t;
+                BigInt a = m.a * coeff + m.b;
+                BigInt c = m.c * coeff + m.d;
+                m.b = std::move(m.a);
+                m.d = std::move(m.c);
+                m.a = std::move(a);
+                m.c = std::move(c);
+            }
+            return m;
+        }
+
+        /**
+         * @brief Узел дерева; при threads > 1 левое поддерево считается в отдельном потоке
+         */
+        BigMatrix product_tree(std::span<const long long> terms, unsigned threads) {
+            if (terms.size() <= LEAF_TERMS) {
+                return leaf_product(terms);
+            }
+
+            const size_t half = terms.size() / 2;
+            if (threads < 2 || terms.size() < PARALLEL_MIN_TERMS) {
+                return product_tree(terms.first(half), 1) * product_tree(terms.subspan(half), 1);
+            }
+
+            const unsigned left_threads = threads / 2;
+            BigMatrix left;
+            std::exception_ptr failure;
+            std::thread worker([&] {
+                try {
+                    left = product_tree(terms.first(half), left_threads);
+                } catch (...) {
+                    failure = std::current_exception();
+                }
+            });
+
+            BigMatrix right;
+            try {
+                right = product_tree(terms.subspan(half), threads - left_threads);
+            } catch (...) {
+                worker.join();
+                throw;
+            }
+            worker.join();
+            if (failure) {
+                std::rethrow_exception(failure);
+            }
+            return left * right;
+        }
+    }
+
+    /**
+     * @brief Произведение матриц
+     */
+    BigMatrix operator*(const BigMatrix& x, const BigMatrix& y) {
+        return {x.a * y.a + x.b * y.c, x.a * y.b + x.b * y.d,
+                x.c * y.a + x.d * y.c, x.c * y.b + x.d * y.d};
+    }
+
+    /**
+     * @brief Произведение матриц коэффициентов
+     */
+    BigMatrix term_product(std::span<const long long> terms, unsigned threads) {
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        return product_tree(terms, threads);
+    }
+
+    /**
+     * @brief Подходящая дробь деревом произведений
+     *
+     * Коэффициенты конечной дроби используются без копирования;
+     * для периодической дроби за концом буфера они разворачиваются
+     * во временный массив.
+     */
+    std::pair<BigInt, BigInt> tree_convergent(const ContinuedFractionView& view, size_t n,
+                                              unsigned threads) {
+        if (n >= view.size() && view.is_finite()) {
+            throw std::out_of_range("Индекс подходящей дроби вне диапазона");
+        }
+
+        BigMatrix m;
+        if (n < view.size()) {
+            m = term_product(view.coefficients().first(n + 1), threads);
+        } else {
+            std::vector<long long> terms(n + 1);
+            for (size_t i = 0; i <= n; ++i) {
+                terms[i] = view.coefficient_at(i);
+            }
+            m = term_product(terms, threads);
+        }
+        return {std::move(m.a), std::move(m.c)};
+    }
+}
@@ -0,0 +1,73 @@
+/**
+ * @file matrix_product.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Подходящие дроби произведением матриц 2×2 (binary splitting)
+ *
+ * Коэффициенту a соответствует матрица M(a) = [[a, 1], [1, 0]], и
+ *
+ *   M(a₀)·M(a₁)···M(aₙ) = [[pₙ, pₙ₋₁], [qₙ, qₙ₋₁]].
+ *
+ * Линейная рекуррентная формула на каждом шаге умножает растущее
+ * большое число на маленький коэффициент, и при n порядка миллионов
+ * основное время уходит на длинную цепочку таких умножений.
+ * Сбалансированное дерево произведений перемножает матрицы близкого
+ * размера, поэтому работа сосредоточена в немногих умножениях больших
+ * чисел (алгоритм Карацубы в BigInt), а независимые поддеревья можно
+ * вычислять в разных потоках.
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef MATRIX_PRODUCT_H
+#define MATRIX_PRODUCT_H
+
+#include "big_integer.h"
+#include "continued_fraction_view.h"
+#include <cstddef>
+#include <span>
+#include <utility>
+
+namespace Math {
+    /**
+     * @struct BigMatrix
+     * @brief Матрица 2×2 [[a, b], [c, d]] над BigInt
+     */
+    struct BigMatrix {
+        BigInt a = 1, b = 0;
+        BigInt c = 0, d = 1;
+    };
+
+    /**
+     * @brief Произведение матриц
+     */
+    BigMatrix operator*(const BigMatrix& x, const BigMatrix& y);
+
+    /**
+     * @brief Произведение M(t₀)·M(t₁)···M(tₖ₋₁)
+     *
+     * Для пустого диапазона - единичная матрица.
+     *
+     * @param terms Коэффициенты
+     * @param threads Количество потоков (0 - по числу ядер)
+     */
+    BigMatrix term_product(std::span<const long long> terms, unsigned threads = 1);
+
+    /**
+     * @brief n-я подходящая дробь деревом произведений
+     *
+     * Результат совпадает с ContinuedFraction::exact_convergent(n).
+     * Коэффициенты периодической дроби за концом хранимого буфера
+     * берутся циклически из периода.
+     *
+     * @param view Дробь
+     * @param n Индекс подходящей дроби
+     * @param threads Количество потоков (0 - по числу ядер)
+     * @return Пара {pₙ, qₙ}
+     * @throw std::out_of_range При n ≥ size() у конечной дроби
+     */
+    std::pair<BigInt, BigInt> tree_convergent(const ContinuedFractionView& view, size_t n,
+                                              unsigned threads = 0);
+}
+
+#endif // MATRIX_PRODUCT_H
@@ -0,0 +1,200 @@
+/**
+ * @file pell.cpp
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Параллельное вычисление периодов √n и решений уравнения Пелля
+ */
+
+#include "pell.h"
+#include "matrix_product.h"
+#include "sqrt_expansion.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace Math {
+    namespace {
+        constexpr size_t RANGE_CHUNK = 64;   ///< Чисел в одном блоке работы
+
+        /**
+         * @brief Дописать в арену a₀ и период √n
+         * @return Количество дописанных коэффициентов
+         */
+        size_t append_sqrt_expansion(long long n, std::vector<long long>& arena) {
+            detail::SqrtTermGenerator terms(n);
+            arena.push_back(terms.a0());
+            if (terms.is_perfect_square()) {
+                return 1;
+            }
+
+            size_t length = 1;
+            long long a;
+            do {
+                a = terms.next();
+                arena.push_back(a);
+                ++length;
+            } while (!terms.closes_period(a));
+            return length;
+        }
+
+        /**
+         * @brief X·Xᵀ (результат симметричен, поэтому нужно меньше умножений)
+         */
+        BigMatrix multiply_transposed(const BigMatrix& x) {
+            BigInt off_diagonal = x.a * x.c + x.b * x.d;
+            BigInt top = x.a * x.a + x.b * x.b;
+            BigInt bottom = x.c * x.c + x.d * x.d;
+            return {std::move(top), off_diagonal, off_diagonal, std::move(bottom)};
+        }
+
+        /**
+         * @brief Фундаментальное решение по разложению [a₀; (a₁, ..., aᵣ)]
+         *
+         * Период без последнего коэффициента a₁, ..., aᵣ₋₁ - палиндром,
+         * а матрицы M(t) симметричны, поэтому для H = M(a₁)···M(aₕ)
+         * произведение по всему палиндрому равно H·Hᵀ (или H·M(aₕ₊₁)·Hᵀ
+         * при нечетной длине): достаточно половины периода.
+         *
+         * M(a₀)·M(a₁)···M(aᵣ₋₁) = [[pᵣ₋₁, pᵣ₋₂], [qᵣ₋₁, qᵣ₋₂]]. При четном r
+         * решение - (pᵣ₋₁, qᵣ₋₁); при нечетном pᵣ₋₁² - n·qᵣ₋₁² = -1,
+         * и решение получается возведением в квадрат: (p² + n·q², 2pq).
+         */
+        PellSolution pell_from_expansion(long long n, std::span<const long long> expansion) {
+            const size_t period = expansion.size() - 1;
+            if (period == 0) {
+                return {1, 0};
+            }
+
+            const std::span<const long long> palindrome = expansion.subspan(1, period - 1);
+            const size_t half = palindrome.size() / 2;
+            const BigMatrix head = term_product(palindrome.first(half));
+
+            BigMatrix middle;
+            if (palindrome.size() % 2 == 0) {
+                middle = multiply_transposed(head);
+            } else {
+                const BigMatrix center = {palindrome[half], 1, 1, 0};
+                const BigMatrix left = head * center;
+                // H·M·Hᵀ: правый множитель Hᵀ записан явно
+                middle = left * BigMatrix{head.a, head.c, head.b, head.d};
+            }
+
+            // Первая строка M(a₀)·middle: (a₀·m.a + m.c, a₀·m.b + m.d), вторая - (m.a, m.b)
+            BigInt p = BigInt(expansion[0]) * middle.a + middle.c;
+            BigInt q = std::move(middle.a);
+
+            if (period % 2 == 0) {
+                return {std::move(p), std::move(q)};
+            }
+            BigInt x = p * p + BigInt(n) * q * q;
+            BigInt y = BigInt(2) * p * q;
+            return {std::move(x), std::move(y)};
+        }
+    }
+
+    /**
+     * @brief Решение уравнения Пелля для одного n
+     */
+    PellSolution solve_pell(long long n) {
+        if (n < 0) {
+            throw std::invalid_argument("Уравнение Пелля определено только для n >= 0");
+        }
+
+        std::vector<long long> expansion;
+        append_sqrt_expansion(n, expansion);
+        return pell_from_expansion(n, expansion);
+    }
+
+    /**
+     * @brief Разложение из арены
+     */
+    ContinuedFractionView SqrtPellTable::expansion(size_t i) const {
+        const Entry& entry = entries_[i];
+        const std::span<const long long> coeffs(arenas_[entry.arena].data() + entry.offset, entry.length);
+        return ContinuedFractionView(coeffs, entry.length > 1 ? 1 : ContinuedFractionView::npos);
+    }
+
+    /**
+     * @brief Параллельное заполнение таблицы
+     */
+    SqrtPellTable sqrt_pell_range(long long lo, long long hi, unsigned threads) {
+        if (lo < 0 || lo > hi) {
+            throw std::invalid_argument("Неверный диапазон чисел для вычисления периодов");
+        }
+
+        const size_t count = static_cast<size_t>(hi - lo);
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        const size_t chunks = (count + RANGE_CHUNK - 1) / RANGE_CHUNK;
+        threads = static_cast<unsigned>(std::min<size_t>(threads, std::max<size_t>(chunks, 1)));
+
+        SqrtPellTable table;
+        table.lo_ = lo;
+        table.entries_.resize(count);
+        table.arenas_.resize(threads);
+
+        std::atomic<size_t> next_chunk{0};
+        std::exception_ptr failure;
+        std::mutex failure_mutex;
+
+        auto worker = [&](unsigned id) {
+            std::vector<long long>& arena = table.arenas_[id];
+            try {
+                for (size_t chunk = next_chunk.fetch_add(1); chunk < chunks;
+                     chunk = next_chunk.fetch_add(1)) {
+                    const size_t first = chunk * RANGE_CHUNK;
+                    const size_t last = std::min(count, first + RANGE_CHUNK);
+                    for (size_t i = first; i < last; ++i) {
+                        SqrtPellTable::Entry& entry = table.entries_[i];
+                        entry.arena = id;
+                        entry.offset = arena.size();
+                        entry.length = append_sqrt_expansion(lo + static_cast<long long>(i), arena);
+                        entry.solution = pell_from_expansion(lo + static_cast<long long>(i),
+                            std::span<const long long>(arena.data() + entry.offset, entry.length));
+                    }
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(failure_mutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+                next_chunk.store(chunks);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(threads - 1);
+        for (unsigned id = 1; id < threads; ++id) {
+            try {
+                pool.emplace_back(worker, id);
+            } catch (const std::system_error&) {
+                // Поток не создан: блоки берутся из общего счетчика, поэтому
+                // оставшиеся разберут уже запущенные потоки и текущий
+                break;
+            }
+        }
+        try {
+            worker(0);
+        } catch (...) {
+            for (std::thread& thread : pool) {
+                thread.join();
+            }
+            throw;
+        }
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+        return table;
+    }
+}
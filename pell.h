@@ -0,0 +1,123 @@
+/**
+ * @file pell.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Периоды √n и фундаментальные решения уравнения Пелля
+ *
+ * Для неполного квадрата n разложение √n периодично:
+ * √n = [a₀; (a₁, ..., aᵣ)], aᵣ = 2a₀. Фундаментальное решение
+ * уравнения x² - n·y² = 1 - подходящая дробь p/q с индексом r - 1
+ * при четном r и 2r - 1 при нечетном.
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef PELL_H
+#define PELL_H
+
+#include "big_integer.h"
+#include "continued_fraction_view.h"
+#include <cstddef>
+#include <vector>
+
+namespace Math {
+    /**
+     * @struct PellSolution
+     * @brief Решение уравнения x² - n·y² = 1
+     *
+     * Для полного квадрата n хранится тривиальное решение (1, 0).
+     */
+    struct PellSolution {
+        BigInt x;   ///< x
+        BigInt y;   ///< y
+    };
+
+    /**
+     * @brief Фундаментальное решение уравнения x² - n·y² = 1
+     *
+     * Вычисляется по половине периода √n деревом произведений матриц 2×2
+     * в BigInt, поэтому длинные периоды не приводят к переполнению.
+     *
+     * @param n Неотрицательное число
+     * @return Наименьшее решение с y > 0 или (1, 0) для полного квадрата
+     * @throw std::invalid_argument При n < 0
+     */
+    PellSolution solve_pell(long long n);
+
+    /**
+     * @class SqrtPellTable
+     * @brief Периоды √n и решения уравнения Пелля для всех n из [lo, hi)
+     *
+     * Коэффициенты хранятся в аренах - по одной на рабочий поток, -
+     * и выдаются как невладеющие представления [a₀; (a₁, ..., aᵣ)].
+     */
+    class SqrtPellTable {
+    public:
+        /**
+         * @brief Пустая таблица
+         */
+        SqrtPellTable() : lo_(0) {}
+
+        /**
+         * @brief Количество чисел в таблице
+         */
+        size_t size() const { return entries_.size(); }
+
+        /**
+         * @brief Первое число диапазона
+         */
+        long long lo() const { return lo_; }
+
+        /**
+         * @brief Разложение √(lo + i)
+         * @return [a₀; (a₁, ..., aᵣ)] или [a₀] для полного квадрата
+         */
+        ContinuedFractionView expansion(size_t i) const;
+
+        /**
+         * @brief Длина периода √(lo + i) (0 для полного квадрата)
+         */
+        size_t period_length(size_t i) const { return entries_[i].length - 1; }
+
+        /**
+         * @brief Фундаментальное решение x² - (lo + i)·y² = 1
+         */
+        const PellSolution& pell(size_t i) const { return entries_[i].solution; }
+
+    private:
+        friend SqrtPellTable sqrt_pell_range(long long lo, long long hi, unsigned threads);
+
+        /**
+         * @struct Entry
+         * @brief Строка таблицы: расположение коэффициентов и решение
+         */
+        struct Entry {
+            unsigned arena = 0;      ///< Номер арены
+            size_t offset = 0;       ///< Смещение a₀ в арене
+            size_t length = 0;       ///< a₀ и период
+            PellSolution solution;   ///< Решение уравнения Пелля
+        };
+
+        long long lo_;                                  ///< Первое число диапазона
+        std::vector<Entry> entries_;                   ///< Строки таблицы, entries_[i] - для lo + i
+        std::vector<std::vector<long long>> arenas_;   ///< Коэффициенты, по арене на поток
+    };
+
+    /**
+     * @brief Вычислить периоды √n и решения уравнения Пелля для n из [lo, hi)
+     *
+     * Диапазон делится на небольшие блоки, которые рабочие потоки
+     * забирают по атомарному счетчику, поэтому неравномерная длина
+     * периодов не приводит к простою потоков. Таблица результатов
+     * выделяется заранее, и каждый поток пишет только в свои строки.
+     *
+     * @param lo Начало диапазона (≥ 0)
+     * @param hi Конец диапазона (не включается)
+     * @param threads Количество потоков (0 - по числу ядер)
+     * @return Таблица результатов
+     * @throw std::invalid_argument При lo < 0 или lo > hi
+     */
+    SqrtPellTable sqrt_pell_range(long long lo, long long hi, unsigned threads = 0);
+}
+
+#endif // PELL_H
@@ -0,0 +1,106 @@
+/**
+ * @file pi_expansion.cpp
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Вычисление π с гарантированной точностью и его разложение
+ */
+
+#include "pi_expansion.h"
+#include "big_integer.h"
+#include <stdexcept>
+
+namespace Math {
+    namespace detail {
+        namespace {
+            /**
+             * @brief Средняя длина коэффициента π в битах с запасом
+             *
+             * По теореме Леви знаменатели подходящих дробей почти всех чисел
+             * растут как e^(1.1866·n), и каждый коэффициент требует около
+             * 2·1.1866 / ln 2 ≈ 3.42 бита точности.
+             */
+            constexpr size_t BITS_PER_TERM = 4;
+            constexpr size_t GUARD_BITS = 64;   ///< Дополнительная точность
+
+            /**
+             * @brief arctg(1/x)·scale в целых числах
+             *
+             * Ряд arctg(1/x) = Σ (-1)ʲ / ((2j + 1)·x^(2j+1)) суммируется до
+             * обнуления степени. Каждое деление с усечением ошибается меньше
+             * чем на 2 (степень) и 3 (член ряда), отброшенный остаток ряда
+             * меньше 2, поэтому |результат - точное значение| ≤ 3·(terms + 1).
+             *
+             * @param terms Количество просуммированных членов
+             */
+            BigInt arctan_inverse(long long x, const BigInt& scale, size_t& terms) {
+                const BigInt square = BigInt(x) * BigInt(x);
+                BigInt power = scale / BigInt(x);
+                BigInt sum = power;
+                terms = 1;
+                for (long long j = 1;; ++j) {
+                    power /= square;
+                    if (power.is_zero()) {
+                        break;
+                    }
+                    const BigInt term = power / BigInt(2 * j + 1);
+                    if (j % 2 == 0) {
+                        sum += term;
+                    } else {
+                        sum -= term;
+                    }
+                    ++terms;
+                }
+                return sum;
+            }
+
+            /**
+             * @brief Общие коэффициенты разложений a/b и c/d (не более count)
+             */
+            std::vector<long long> common_terms(BigInt a, BigInt b, BigInt c, BigInt d,
+                                                size_t count) {
+                std::vector<long long> terms;
+                BigInt q1, r1, q2, r2;
+                while (terms.size() < count && !b.is_zero() && !d.is_zero()) {
+                    BigInt::floor_divmod(a, b, q1, r1);
+                    BigInt::floor_divmod(c, d, q2, r2);
+                    if (q1 != q2) {
+                        break;
+                    }
+                    const std::optional<long long> term = q1.to_int64();
+                    if (!term) {
+                        throw std::overflow_error("Коэффициент разложения π не помещается в long long");
+                    }
+                    terms.push_back(*term);
+
+                    // x ↦ 1/(x - q): числители и знаменатели меняются местами
+                    a = std::move(b); b = std::move(r1);
+                    c = std::move(d); d = std::move(r2);
+                }
+                return terms;
+            }
+        }
+
+        /**
+         * @brief Коэффициенты π по интервалу, вычисленному по формуле Мэчина
+         */
+        std::vector<long long> pi_terms(size_t count) {
+            if (count == 0) {
+                return {};
+            }
+
+            for (size_t bits = BITS_PER_TERM * count + GUARD_BITS;; bits *= 2) {
+                const BigInt scale = BigInt::power_of_two(bits);
+                size_t terms5 = 0, terms239 = 0;
+                const BigInt pi = BigInt(16) * arctan_inverse(5, scale, terms5) -
+                                  BigInt(4) * arctan_inverse(239, scale, terms239);
+                const BigInt error = BigInt(static_cast<long long>(
+                    16 * 3 * (terms5 + 1) + 4 * 3 * (terms239 + 1)));
+
+                std::vector<long long> terms = common_terms(pi - error, scale, pi + error, scale, count);
+                if (terms.size() == count) {
+                    return terms;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,37 @@
+/**
+ * @file pi_expansion.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Коэффициенты разложения π в цепную дробь
+ *
+ * Общая реализация для pi_continued_fraction и lazy_pi_continued_fraction.
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef PI_EXPANSION_H
+#define PI_EXPANSION_H
+
+#include <cstddef>
+#include <vector>
+
+namespace Math {
+    namespace detail {
+        /**
+         * @brief Первые count коэффициентов π = [3; 7, 15, 1, 292, ...]
+         *
+         * π вычисляется в двоичной фиксированной точке по формуле Мэчина
+         * π = 16·arctg(1/5) - 4·arctg(1/239) вместе с гарантированной
+         * границей погрешности, то есть как интервал [L, U] ∋ π.
+         * Алгоритм Евклида выполняется одновременно для L и U, и
+         * коэффициент выдается, только если он одинаков для обеих
+         * границ, - поэтому все выданные коэффициенты точны. Если
+         * точности не хватило, она удваивается.
+         *
+         * @throw std::overflow_error Если коэффициент не помещается в long long
+         */
+        std::vector<long long> pi_terms(size_t count);
+    }
+}
+
+#endif // PI_EXPANSION_H
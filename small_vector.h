@@ -0,0 +1,258 @@
+/**
+ * @file small_vector.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Непрерывный буфер со встроенным хранилищем для малого числа элементов
+ *
+ * Пока элементов не больше N, они хранятся внутри объекта, и создание,
+ * копирование и уничтожение не обращаются к распределителю памяти.
+ * При переполнении содержимое переносится в std::pmr::vector, память
+ * для которого выделяет заданный std::pmr::memory_resource (по
+ * умолчанию - std::pmr::get_default_resource()).
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Math {
+    /**
+     * @class SmallVector
+     * @brief Аналог std::vector<T> с N встроенными элементами (SBO)
+     *
+     * Поддерживает подмножество интерфейса std::vector, нужное
+     * ContinuedFraction. Итераторы - обычные указатели, поэтому буфер
+     * приводится к std::span. Переход во внешний буфер необратим:
+     * после clear() емкость сохраняется, как у std::vector.
+     *
+     * Распределитель подчиняется правилам std::pmr: копия получает
+     * ресурс по умолчанию, перемещение забирает ресурс источника,
+     * присваивание сохраняет ресурс приемника.
+     *
+     * @tparam T Тривиально копируемый тип элементов
+     * @tparam N Количество встроенных элементов
+     */
+    template <typename T, size_t N>
+    class SmallVector {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "SmallVector хранит только тривиально копируемые типы");
+        static_assert(N > 0, "Встроенный буфер не может быть пустым");
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using allocator_type = std::pmr::polymorphic_allocator<T>;
+
+        // ==================== КОНСТРУКТОРЫ ====================
+
+        SmallVector() = default;
+
+        explicit SmallVector(const allocator_type& alloc) noexcept : heap_(alloc) {}
+
+        SmallVector(std::initializer_list<T> values) {
+            insert(end(), values.begin(), values.end());
+        }
+
+        SmallVector(size_t count, const T& value, const allocator_type& alloc = {})
+            : heap_(alloc) {
+            resize(count, value);
+        }
+
+        template <std::forward_iterator ForwardIt>
+        SmallVector(ForwardIt first, ForwardIt last, const allocator_type& alloc = {})
+            : heap_(alloc) {
+            insert(end(), first, last);
+        }
+
+        /**
+         * @brief Копирование содержимого std::vector
+         */
+        explicit SmallVector(const std::vector<T>& values, const allocator_type& alloc = {})
+            : heap_(alloc) {
+            insert(end(), values.begin(), values.end());
+        }
+
+        SmallVector(const SmallVector& other) = default;
+        SmallVector(SmallVector&& other) noexcept = default;
+        SmallVector& operator=(const SmallVector& other) = default;
+        SmallVector& operator=(SmallVector&& other) = default;
+
+        /**
+         * @brief Копирование с заданным распределителем
+         */
+        SmallVector(const SmallVector& other, const allocator_type& alloc)
+            : heap_(other.heap_, alloc)
+            , inline_(other.inline_)
+            , size_(other.size_)
+            , on_heap_(other.on_heap_) {}
+
+        /**
+         * @brief Перемещение с заданным распределителем
+         *
+         * При разных ресурсах внешний буфер копируется.
+         */
+        SmallVector(SmallVector&& other, const allocator_type& alloc)
+            : heap_(std::move(other.heap_), alloc)
+            , inline_(other.inline_)
+            , size_(other.size_)
+            , on_heap_(other.on_heap_) {}
+
+        /**
+         * @brief Распределитель внешнего буфера
+         */
+        allocator_type get_allocator() const noexcept { return heap_.get_allocator(); }
+
+        // ==================== РАЗМЕР И ДОСТУП ====================
+
+        size_t size() const noexcept { return on_heap_ ? heap_.size() : size_; }
+        bool empty() const noexcept { return size() == 0; }
+        size_t capacity() const noexcept { return on_heap_ ? heap_.capacity() : N; }
+
+        /**
+         * @brief Хранятся ли элементы во встроенном буфере
+         */
+        bool is_inline() const noexcept { return !on_heap_; }
+
+        T* data() noexcept { return on_heap_ ? heap_.data() : inline_.data(); }
+        const T* data() const noexcept { return on_heap_ ? heap_.data() : inline_.data(); }
+
+        iterator begin() noexcept { return data(); }
+        iterator end() noexcept { return data() + size(); }
+        const_iterator begin() const noexcept { return data(); }
+        const_iterator end() const noexcept { return data() + size(); }
+
+        T& operator[](size_t i) noexcept { return data()[i]; }
+        const T& operator[](size_t i) const noexcept { return data()[i]; }
+
+        T& front() noexcept { return data()[0]; }
+        const T& front() const noexcept { return data()[0]; }
+        T& back() noexcept { return data()[size() - 1]; }
+        const T& back() const noexcept { return data()[size() - 1]; }
+
+        // ==================== МОДИФИКАЦИЯ ====================
+
+        void reserve(size_t capacity) {
+            if (on_heap_) {
+                heap_.reserve(capacity);
+            } else if (capacity > N) {
+                spill(capacity);
+            }
+        }
+
+        void push_back(const T& value) {
+            if (on_heap_) {
+                heap_.push_back(value);
+            } else if (size_ < N) {
+                inline_[size_++] = value;
+            } else {
+                const T copy = value;   // value может ссылаться на inline_
+                spill(2 * N);
+                heap_.push_back(copy);
+            }
+        }
+
+        void pop_back() noexcept {
+            if (on_heap_) {
+                heap_.pop_back();
+            } else {
+                --size_;
+            }
+        }
+
+        void clear() noexcept {
+            heap_.clear();
+            size_ = 0;
+        }
+
+        void resize(size_t count, const T& value = T()) {
+            if (on_heap_) {
+                heap_.resize(count, value);
+            } else if (count <= N) {
+                if (count > size_) {
+                    std::fill(inline_.begin() + size_, inline_.begin() + count, value);
+                }
+                size_ = count;
+            } else {
+                const T copy = value;
+                spill(count);
+                heap_.resize(count, copy);
+            }
+        }
+
+        void assign(size_t count, const T& value) {
+            const T copy = value;
+            clear();
+            resize(count, copy);
+        }
+
+        template <std::forward_iterator ForwardIt>
+        void assign(ForwardIt first, ForwardIt last) {
+            clear();
+            insert(end(), first, last);
+        }
+
+        /**
+         * @brief Вставка диапазона перед pos
+         * @return Итератор на первый вставленный элемент
+         */
+        template <std::forward_iterator ForwardIt>
+        iterator insert(const_iterator pos, ForwardIt first, ForwardIt last) {
+            const size_t offset = static_cast<size_t>(pos - data());
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            if (!on_heap_ && size_ + count <= N) {
+                std::copy_backward(inline_.begin() + offset, inline_.begin() + size_,
+                                   inline_.begin() + size_ + count);
+                std::copy(first, last, inline_.begin() + offset);
+                size_ += count;
+                return begin() + offset;
+            }
+            if (!on_heap_) {
+                spill(std::max(size_ + count, 2 * N));
+            }
+            heap_.insert(heap_.begin() + static_cast<std::ptrdiff_t>(offset), first, last);
+            return begin() + offset;
+        }
+
+        /**
+         * @brief Копия содержимого в виде std::vector
+         */
+        std::vector<T> to_vector() const {
+            return std::vector<T>(begin(), end());
+        }
+
+        friend bool operator==(const SmallVector& a, const SmallVector& b) {
+            return std::equal(a.begin(), a.end(), b.begin(), b.end());
+        }
+
+    private:
+        std::pmr::vector<T> heap_;   ///< Внешний буфер (используется при on_heap_)
+        std::array<T, N> inline_{};  ///< Встроенный буфер
+        size_t size_ = 0;            ///< Число элементов во встроенном буфере
+        bool on_heap_ = false;       ///< Элементы перенесены в heap_
+
+        /**
+         * @brief Перенести элементы во внешний буфер емкостью не меньше capacity
+         */
+        void spill(size_t capacity) {
+            heap_.reserve(std::max(capacity, size_));
+            heap_.assign(inline_.begin(), inline_.begin() + size_);
+            size_ = 0;
+            on_heap_ = true;
+        }
+    };
+}
+
+#endif // SMALL_VECTOR_H
@@ -0,0 +1,73 @@
+/**
+ * @file sqrt_expansion.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Генератор коэффициентов разложения √n в цепную дробь
+ *
+ * Общая реализация рекуррентной схемы для sqrt_continued_fraction,
+ * lazy_sqrt_continued_fraction и вычислений уравнения Пелля.
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef SQRT_EXPANSION_H
+#define SQRT_EXPANSION_H
+
+#include "checked_arithmetic.h"
+
+namespace Math {
+    namespace detail {
+        /**
+         * @class SqrtTermGenerator
+         * @brief Коэффициенты √n = [a₀; a₁, a₂, ...] в целых числах
+         *
+         * Остаток хранится как (m + √n) / d:
+         * m' = d·a - m, d' = (n - m'²) / d, a' = ⌊(a₀ + m') / d'⌋.
+         * Все промежуточные значения не превосходят 2a₀, поэтому
+         * переполнения нет для любого n ≥ 0 типа long long.
+         * Период заканчивается коэффициентом 2a₀.
+         */
+        class SqrtTermGenerator {
+        public:
+            /**
+             * @param n Неотрицательное число
+             */
+            constexpr explicit SqrtTermGenerator(long long n)
+                : n_(n), a0_(isqrt(n)), m_(0), d_(1), a_(a0_) {}
+
+            /**
+             * @brief Целая часть a₀ = ⌊√n⌋
+             */
+            constexpr long long a0() const { return a0_; }
+
+            /**
+             * @brief Является ли n полным квадратом (разложение [a₀])
+             */
+            constexpr bool is_perfect_square() const { return a0_ * a0_ == n_; }
+
+            /**
+             * @brief Следующий коэффициент a₁, a₂, ... (только для неполного квадрата)
+             */
+            constexpr long long next() {
+                m_ = d_ * a_ - m_;
+                d_ = (n_ - m_ * m_) / d_;
+                a_ = (a0_ + m_) / d_;
+                return a_;
+            }
+
+            /**
+             * @brief Завершает ли коэффициент период
+             */
+            constexpr bool closes_period(long long term) const { return term == 2 * a0_; }
+
+        private:
+            long long n_;    ///< Подкоренное число
+            long long a0_;   ///< ⌊√n⌋
+            long long m_;    ///< Сдвиг числителя остатка
+            long long d_;    ///< Знаменатель остатка
+            long long a_;    ///< Последний выданный коэффициент
+        };
+    }
+}
+
+#endif // SQRT_EXPANSION_H
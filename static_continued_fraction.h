@@ -0,0 +1,332 @@
+/**
+ * @file static_continued_fraction.h
+ * @author КИЗАИДИ АНТОНИУ
+ * @date 14/10/2026
+ * @brief Цепные дроби фиксированной емкости, вычисляемые на этапе компиляции
+ *
+ * StaticContinuedFraction<N> хранит до N коэффициентов в std::array и
+ * является литеральным типом: разложения рациональных чисел, √n и e, а
+ * также таблицы подходящих дробей можно вычислить в constexpr и
+ * разместить в бинарном файле без затрат при запуске:
+ *
+ *   constexpr auto SQRT2 = StaticContinuedFraction<2>::sqrt(2);
+ *   constexpr auto TABLE = SQRT2.convergents<20>();
+ *
+ * Ошибки (переполнение, нехватка емкости) сообщаются исключениями;
+ * при вычислении на этапе компиляции они становятся ошибками компиляции.
+ * Для вычислений во время выполнения дробь преобразуется в
+ * ContinuedFraction через view().
+ *
+ * Лицензия: MIT
+ */
+
+#ifndef STATIC_CONTINUED_FRACTION_H
+#define STATIC_CONTINUED_FRACTION_H
+
+#include "checked_arithmetic.h"
+#include "continued_fraction_view.h"
+#include "sqrt_expansion.h"
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace Math {
+    namespace detail {
+        /**
+         * @brief Коэффициент aᵢ разложения e = [2; 1, 2, 1, 1, 4, 1, 1, 6, ...]
+         */
+        constexpr long long e_term(size_t index) {
+            if (index == 0) {
+                return 2;
+            }
+            // Каждый третий коэффициент, начиная со второго, равен 2(i + 1)/3
+            return index % 3 == 2 ? static_cast<long long>(2 * ((index + 1) / 3)) : 1;
+        }
+    }
+
+    /**
+     * @class StaticContinuedFraction
+     * @brief Регулярная цепная дробь не более чем из N коэффициентов
+     *
+     * В отличие от ContinuedFraction, коэффициенты не нормализуются:
+     * после a₀ допускаются только aᵢ ≥ 1. Периодическая дробь хранит
+     * предпериод и один период.
+     *
+     * @tparam N Емкость (наибольшее количество коэффициентов)
+     */
+    template <size_t N>
+    class StaticContinuedFraction {
+        static_assert(N > 0, "Емкость дроби должна быть положительной");
+
+    public:
+        static constexpr size_t npos = ContinuedFractionView::npos;
+
+        // ==================== КОНСТРУКТОРЫ ====================
+
+        /**
+         * @brief Дробь [0]
+         */
+        constexpr StaticContinuedFraction() noexcept = default;
+
+        /**
+         * @brief Целое число [value]
+         */
+        constexpr explicit StaticContinuedFraction(long long value) noexcept {
+            coefficients_[0] = value;
+        }
+
+        /**
+         * @brief Конечная дробь из готовых коэффициентов
+         * @throw std::length_error Если коэффициентов больше N
+         * @throw std::invalid_argument При пустом списке или aᵢ < 1 (i ≥ 1)
+         */
+        constexpr StaticContinuedFraction(std::initializer_list<long long> coeffs) {
+            assign(coeffs.begin(), coeffs.size(), npos);
+        }
+
+        /**
+         * @brief Периодическая дробь [pre; (period)]
+         * @throw std::length_error Если коэффициентов больше N
+         * @throw std::invalid_argument При пустом периоде или aᵢ < 1 (i ≥ 1)
+         */
+        static constexpr StaticContinuedFraction periodic(std::initializer_list<long long> pre,
+                                                          std::initializer_list<long long> period) {
+            if (pre.size() + period.size() > N) {
+                throw std::length_error("Коэффициенты не помещаются в StaticContinuedFraction");
+            }
+            if (period.size() == 0) {
+                throw std::invalid_argument("Период не может быть пустым");
+            }
+
+            std::array<long long, N> buffer{};
+            size_t count = 0;
+            for (long long coeff : pre) {
+                buffer[count++] = coeff;
+            }
+            for (long long coeff : period) {
+                buffer[count++] = coeff;
+            }
+
+            StaticContinuedFraction result;
+            result.assign(buffer.data(), count, pre.size());
+            return result;
+        }
+
+        /**
+         * @brief Разложение рационального числа numerator/denominator
+         *
+         * Алгоритм Евклида с округлением частных вниз, как в
+         * ContinuedFraction::from_rational().
+         *
+         * @throw std::invalid_argument При нулевом знаменателе
+         * @throw std::length_error Если разложение длиннее N
+         */
+        static constexpr StaticContinuedFraction from_rational(long long numerator,
+                                                               long long denominator) {
+            if (denominator == 0) {
+                throw std::invalid_argument("Знаменатель не может быть нулевым");
+            }
+
+            StaticContinuedFraction result;
+            result.size_ = 0;
+            long long n = numerator;
+            long long d = denominator;
+            while (d != 0) {
+                if (result.size_ == N) {
+                    throw std::length_error("Разложение не помещается в StaticContinuedFraction");
+                }
+                const long long q = detail::floor_div(n, d);
+                const long long r = n - q * d;
+                result.coefficients_[result.size_++] = q;
+                n = d;
+                d = r;
+            }
+            return result;
+        }
+
+        /**
+         * @brief Первые terms коэффициентов e
+         * @throw std::length_error При terms > N
+         */
+        static constexpr StaticContinuedFraction e(size_t terms = N) {
+            if (terms > N) {
+                throw std::length_error("Разложение не помещается в StaticContinuedFraction");
+            }
+
+            StaticContinuedFraction result;
+            result.size_ = terms == 0 ? 1 : terms;
+            for (size_t i = 0; i < result.size_; ++i) {
+                result.coefficients_[i] = detail::e_term(i);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Периодическое разложение √n = [a₀; (a₁, ..., aᵣ)]
+         *
+         * Для полного квадрата - [a₀].
+         *
+         * @throw std::invalid_argument При отрицательном n
+         * @throw std::length_error Если период не помещается в N - 1 коэффициент
+         */
+        static constexpr StaticContinuedFraction sqrt(long long n) {
+            if (n < 0) {
+                throw std::invalid_argument("Нельзя вычислить корень из отрицательного числа");
+            }
+
+            detail::SqrtTermGenerator generator(n);
+            StaticContinuedFraction result(generator.a0());
+            if (generator.is_perfect_square()) {
+                return result;
+            }
+
+            result.period_start_ = 1;
+            while (true) {
+                if (result.size_ == N) {
+                    throw std::length_error("Период не помещается в StaticContinuedFraction");
+                }
+                const long long term = generator.next();
+                result.coefficients_[result.size_++] = term;
+                if (generator.closes_period(term)) {
+                    return result;
+                }
+            }
+        }
+
+        // ==================== СВОЙСТВА ====================
+
+        constexpr size_t size() const noexcept { return size_; }
+        constexpr bool is_finite() const noexcept { return period_start_ == npos; }
+        constexpr bool is_periodic() const noexcept { return period_start_ != npos; }
+        constexpr size_t period_start() const noexcept { return period_start_; }
+
+        /**
+         * @brief Хранимый коэффициент с индексом i < size()
+         */
+        constexpr long long operator[](size_t i) const noexcept { return coefficients_[i]; }
+
+        /**
+         * @brief Коэффициенты (для периодической дроби - предпериод и один период)
+         */
+        constexpr std::span<const long long> coefficients() const noexcept {
+            return std::span<const long long>(coefficients_.data(), size_);
+        }
+
+        /**
+         * @brief Невладеющее представление для вычислений во время выполнения
+         */
+        constexpr ContinuedFractionView view() const noexcept {
+            return ContinuedFractionView(coefficients(), period_start_);
+        }
+
+        /**
+         * @brief Коэффициент с индексом i; у периодической дроби i не ограничен
+         * @throw std::out_of_range При i ≥ size() у конечной дроби
+         */
+        constexpr long long coefficient_at(size_t i) const {
+            if (i < size_) {
+                return coefficients_[i];
+            }
+            if (is_finite()) {
+                throw std::out_of_range("Индекс коэффициента вне диапазона");
+            }
+            const size_t period = size_ - period_start_;
+            return coefficients_[period_start_ + (i - period_start_) % period];
+        }
+
+        // ==================== ПОДХОДЯЩИЕ ДРОБИ ====================
+
+        /**
+         * @brief n-я подходящая дробь pₙ/qₙ
+         * @throw std::out_of_range При n ≥ size() у конечной дроби
+         * @throw std::overflow_error Если pₙ или qₙ не помещается в long long
+         */
+        constexpr std::pair<long long, long long> convergent(size_t n) const {
+            long long p = 1, p_prev = 0;
+            long long q = 0, q_prev = 1;
+            for (size_t i = 0; i <= n; ++i) {
+                const long long coeff = coefficient_at(i);
+                const long long next_p = detail::mul_add_or_throw(coeff, p, p_prev);
+                const long long next_q = detail::mul_add_or_throw(coeff, q, q_prev);
+                p_prev = p; q_prev = q;
+                p = next_p; q = next_q;
+            }
+            return {p, q};
+        }
+
+        /**
+         * @brief Таблица первых M подходящих дробей за один проход
+         *
+         * По умолчанию M = N: все подходящие дроби конечной дроби
+         * полной длины или первые N подходящих дробей периодической.
+         *
+         * @throw std::out_of_range При M > size() у конечной дроби
+         * @throw std::overflow_error Если значение не помещается в long long
+         */
+        template <size_t M = N>
+        constexpr std::array<std::pair<long long, long long>, M> convergents() const {
+            std::array<std::pair<long long, long long>, M> table{};
+            long long p = 1, p_prev = 0;
+            long long q = 0, q_prev = 1;
+            for (size_t i = 0; i < M; ++i) {
+                const long long coeff = coefficient_at(i);
+                const long long next_p = detail::mul_add_or_throw(coeff, p, p_prev);
+                const long long next_q = detail::mul_add_or_throw(coeff, q, q_prev);
+                p_prev = p; q_prev = q;
+                p = next_p; q = next_q;
+                table[i] = {p, q};
+            }
+            return table;
+        }
+
+        // ==================== СРАВНЕНИЕ ====================
+
+        /**
+         * @brief Совпадение коэффициентов и начала периода
+         */
+        friend constexpr bool operator==(const StaticContinuedFraction& a,
+                                         const StaticContinuedFraction& b) noexcept {
+            if (a.size_ != b.size_ || a.period_start_ != b.period_start_) {
+                return false;
+            }
+            for (size_t i = 0; i < a.size_; ++i) {
+                if (a.coefficients_[i] != b.coefficients_[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        std::array<long long, N> coefficients_{};   ///< Коэффициенты [0, size_)
+        size_t size_ = 1;                           ///< Количество коэффициентов
+        size_t period_start_ = npos;                ///< Начало периода или npos
+
+        /**
+         * @brief Заполнить дробь с проверкой емкости и регулярности
+         */
+        constexpr void assign(const long long* coeffs, size_t count, size_t period_start) {
+            if (count == 0) {
+                throw std::invalid_argument("Цепная дробь должна содержать хотя бы один коэффициент");
+            }
+            if (count > N) {
+                throw std::length_error("Коэффициенты не помещаются в StaticContinuedFraction");
+            }
+            for (size_t i = 1; i < count; ++i) {
+                if (coeffs[i] < 1) {
+                    throw std::invalid_argument("Коэффициенты aᵢ при i ≥ 1 должны быть положительными");
+                }
+            }
+            for (size_t i = 0; i < count; ++i) {
+                coefficients_[i] = coeffs[i];
+            }
+            size_ = count;
+            period_start_ = period_start;
+        }
+    };
+}
+
+#endif // STATIC_CONTINUED_FRACTION_H